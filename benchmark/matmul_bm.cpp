@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Dense>
+#include <strict.hpp>
+
+
+using namespace spp;
+
+
+template <typename T>
+using EigenMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+
+static void set_flops(benchmark::State& state) {
+   const double n = double(state.range(0));
+   state.counters["GFLOPS"]
+       = benchmark::Counter(2. * n * n * n * double(state.iterations()) * 1.e-9,
+                            benchmark::Counter::kIsRate);
+}
+
+
+template <typename T>
+static void bm_eig_matmul(benchmark::State& state) {
+   const long int n = state.range(0);
+   EigenMatrix<T> A = EigenMatrix<T>::Random(n, n);
+   EigenMatrix<T> B = EigenMatrix<T>::Random(n, n);
+   EigenMatrix<T> C(n, n);
+   for(auto _ : state) {
+      C.noalias() = A * B;
+      benchmark::DoNotOptimize(C.data());
+   }
+   set_flops(state);
+}
+
+
+template <typename T>
+static void bm_strict_matmul(benchmark::State& state) {
+   const long int n = state.range(0);
+   Array2D<T> A = random<T>(n, n, -One<T>, One<T>);
+   Array2D<T> B = random<T>(n, n, -One<T>, One<T>);
+   Array2D<T> C(n, n);
+   for(auto _ : state) {
+      C = matmul(A, B);
+      benchmark::DoNotOptimize(C.data());
+   }
+   set_flops(state);
+}
+
+
+template <typename T>
+static void bm_strict_matmul_transpose(benchmark::State& state) {
+   const long int n = state.range(0);
+   Array2D<T> A = random<T>(n, n, -One<T>, One<T>);
+   Array2D<T> B = random<T>(n, n, -One<T>, One<T>);
+   Array2D<T> C(n, n);
+   for(auto _ : state) {
+      C = matmul(A, transpose(B));
+      benchmark::DoNotOptimize(C.data());
+   }
+   set_flops(state);
+}
+
+
+static void set_flops_matvec(benchmark::State& state) {
+   const double n = double(state.range(0));
+   state.counters["GFLOPS"] = benchmark::Counter(
+       2. * n * n * double(state.iterations()) * 1.e-9, benchmark::Counter::kIsRate);
+}
+
+
+template <typename T>
+static void bm_eig_matvec(benchmark::State& state) {
+   const long int n = state.range(0);
+   EigenMatrix<T> A = EigenMatrix<T>::Random(n, n);
+   Eigen::Vector<T, Eigen::Dynamic> x = Eigen::Vector<T, Eigen::Dynamic>::Random(n);
+   Eigen::Vector<T, Eigen::Dynamic> y(n);
+   for(auto _ : state) {
+      y.noalias() = A * x;
+      benchmark::DoNotOptimize(y.data());
+   }
+   set_flops_matvec(state);
+}
+
+
+template <typename T>
+static void bm_strict_matvec(benchmark::State& state) {
+   const long int n = state.range(0);
+   Array2D<T> A = random<T>(n, n, -One<T>, One<T>);
+   Array1D<T> x = random<T>(n, -One<T>, One<T>);
+   Array1D<T> y(n);
+   for(auto _ : state) {
+      y = matvec_prod(A, x);
+      benchmark::DoNotOptimize(y.data());
+   }
+   set_flops_matvec(state);
+}
+
+
+template <typename T>
+static void bm_eig_vecmat(benchmark::State& state) {
+   const long int n = state.range(0);
+   EigenMatrix<T> A = EigenMatrix<T>::Random(n, n);
+   Eigen::RowVector<T, Eigen::Dynamic> x = Eigen::RowVector<T, Eigen::Dynamic>::Random(n);
+   Eigen::RowVector<T, Eigen::Dynamic> y(n);
+   for(auto _ : state) {
+      y.noalias() = x * A;
+      benchmark::DoNotOptimize(y.data());
+   }
+   set_flops_matvec(state);
+}
+
+
+template <typename T>
+static void bm_strict_vecmat(benchmark::State& state) {
+   const long int n = state.range(0);
+   Array2D<T> A = random<T>(n, n, -One<T>, One<T>);
+   Array1D<T> x = random<T>(n, -One<T>, One<T>);
+   Array1D<T> y(n);
+   for(auto _ : state) {
+      y = vecmat_prod(x, A);
+      benchmark::DoNotOptimize(y.data());
+   }
+   set_flops_matvec(state);
+}
+
+
+BENCHMARK(bm_eig_matmul<double>)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(bm_strict_matmul<double>)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(bm_strict_matmul_transpose<double>)->Arg(1024);
+BENCHMARK(bm_eig_matmul<float>)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(bm_strict_matmul<float>)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(bm_eig_matvec<double>)->Arg(256)->Arg(4096);
+BENCHMARK(bm_strict_matvec<double>)->Arg(256)->Arg(4096);
+BENCHMARK(bm_eig_vecmat<double>)->Arg(256)->Arg(4096);
+BENCHMARK(bm_strict_vecmat<double>)->Arg(256)->Arg(4096);
+
+
+BENCHMARK_MAIN();
@@ -12,4 +12,11 @@ echo -e ""
 echo -e ""
 ./fixedarray_clang.x
 
+echo -e "\n\nBENCHMARK MATRIX-MATRIX PRODUCT\n\n"
+./matmul_gcc.x
+echo -e ""
+./matmul_icpx.x
+echo -e ""
+./matmul_clang.x
+
 make clean
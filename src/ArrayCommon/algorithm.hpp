@@ -4,19 +4,163 @@
 #pragma once
 
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 #include "../StrictCommon/config.hpp"
 #include "../StrictCommon/strict_literals.hpp"
 #include "../StrictCommon/strict_traits.hpp"
 #include "../StrictCommon/strict_val.hpp"
 #include "array_traits.hpp"
+#include "gather.hpp"
+#include "packet.hpp"
+#include "parallel.hpp"
+#include "tile.hpp"
 #include "use.hpp"
 
 
 namespace spp::detail {
 
 
+// Returns pointer to the first element if elements of A are stored contiguously,
+// nullptr otherwise.
+template <BaseType Base>
+STRICT_CONSTEXPR_INLINE auto contiguous_data(Base& A) {
+   if constexpr(ContiguousBaseType<RemoveCVRef<Base>>) {
+      return A.data();
+   } else if constexpr(MaybeContiguousBaseType<RemoveCVRef<Base>>) {
+      return A.contiguous_data();
+   } else {
+      using pointer = std::conditional_t<std::is_const_v<Base>, const ValueTypeOf<Base>*,
+                                         ValueTypeOf<Base>*>;
+      return pointer{nullptr};
+   }
+}
+
+
+// Returns pointer to the first element of row i if elements of the row are stored
+// contiguously, nullptr otherwise.
+template <TwoDimBaseType Base>
+STRICT_INLINE auto row_data(Base& A, index_t i) {
+   if constexpr(RowContiguousBaseType<RemoveCVRef<Base>>) {
+      return A.row_data(i);
+   } else if constexpr(ContiguousBaseType<RemoveCVRef<Base>>) {
+      return A.data() + (i * A.cols()).val();
+   } else {
+      using pointer = std::conditional_t<std::is_const_v<Base>, const ValueTypeOf<Base>*,
+                                         ValueTypeOf<Base>*>;
+      return pointer{nullptr};
+   }
+}
+
+
+// Returns pointer to the first element of column j if elements of the column are stored
+// contiguously, nullptr otherwise.
+template <TwoDimBaseType Base>
+STRICT_INLINE auto col_data(Base& A, index_t j) {
+   if constexpr(ColContiguousBaseType<RemoveCVRef<Base>>) {
+      return A.col_data(j);
+   } else {
+      using pointer = std::conditional_t<std::is_const_v<Base>, const ValueTypeOf<Base>*,
+                                         ValueTypeOf<Base>*>;
+      return pointer{nullptr};
+   }
+}
+
+
+template <typename Base1, typename Base2> concept ContiguousCopyable
+    = (ContiguousBaseType<Base1> || MaybeContiguousBaseType<Base1>)
+   && (ContiguousBaseType<Base2> || MaybeContiguousBaseType<Base2>)
+   && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>;
+
+
+// Expressions that write a range of their elements to contiguous memory faster than
+// packet by packet, e.g. vecmat_prod, provide eval_range(p, first, last).
+template <typename Base1, typename Base2> concept RangeEvaluable
+    = OneDimBaseType<Base1> && (ContiguousBaseType<Base2> || MaybeContiguousBaseType<Base2>)
+   && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+   && requires(const Base1& A, ValueTypeOf<Base2>* p, index_t i) { A.eval_range(p, i, i); };
+
+
+template <typename Base1, typename Base2> concept RowCopyable
+    = TwoDimBaseType<Base1> && TwoDimBaseType<Base2>
+   && (RowContiguousBaseType<Base1> || RowContiguousBaseType<Base2>);
+
+
+template <typename Base1, typename Base2> concept ColCopyable
+    = TwoDimBaseType<Base1> && ColContiguousBaseType<Base2>;
+
+
+// memmove is used since slices of the same array may overlap.
+template <Builtin T>
+STRICT_INLINE void copy_contiguous(const Strict<T>* p1, Strict<T>* p2, index_t n) {
+   static_assert(std::is_trivially_copyable_v<Strict<T>>);
+   std::memmove(static_cast<void*>(p2), p1, to_size_t(n) * sizeof(Strict<T>));
+}
+
+
+// Copies runs of consecutive indexes of a slice by an index vector block by block if the
+// other operand is stored contiguously. Returns false if there is no such slice or its runs
+// are too short.
+template <BaseType Base1, BaseType Base2>
+STRICT_INLINE bool copy_index_runs(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
+   if constexpr(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>) {
+      if constexpr(IndexedBaseType<Base1>) {
+         const auto d = A1.indexed_data();
+         auto* p2 = contiguous_data(A2);
+         if(d.data == nullptr || p2 == nullptr || !long_runs(d.index, d.size)) {
+            return false;
+         }
+         for_each_run(d.index, d.size, [&d, p2](long int first, long int i, long int n) {
+            copy_contiguous(d.data + i, p2 + first, index_t{n});
+         });
+         return true;
+      } else if constexpr(IndexedBaseType<Base2>) {
+         const auto* p1 = contiguous_data(A1);
+         const auto d = A2.indexed_data();
+         if(p1 == nullptr || d.data == nullptr || !long_runs(d.index, d.size)) {
+            return false;
+         }
+         // Runs are copied in order, so the last copy wins if an index is repeated.
+         for_each_run(d.index, d.size, [&d, p1](long int first, long int i, long int n) {
+            copy_contiguous(p1 + first, d.data + i, index_t{n});
+         });
+         return true;
+      }
+   }
+   return false;
+}
+
+
+template <BaseType Base>
+STRICT_INLINE bool fill_index_runs(ValueTypeOf<Base> val, Base& A) {
+   if constexpr(IndexedBaseType<Base>) {
+      const auto d = A.indexed_data();
+      if(d.data == nullptr || !long_runs(d.index, d.size)) {
+         return false;
+      }
+      for_each_run(d.index, d.size, [&d, &val](long int, long int i, long int n) {
+         std::fill(d.data + i, d.data + i + n, val);
+      });
+      return true;
+   }
+   return false;
+}
+
+
+// Calls f(i) for every index of A. At run time, indexes may be split across threads,
+// in which case f(i) must only modify the i-th element.
 template <BaseType Base, typename F>
 STRICT_CONSTEXPR_INLINE void apply0(Base& A, F f) {
+   if(!std::is_constant_evaluated() && use_parallel<Base>(A.size())) {
+      parallel_for(A.size(), parallel_grain, [&f](index_t first, index_t last) {
+         for(index_t i = first; i < last; ++i) {
+            f(i);
+         }
+      });
+      return;
+   }
    for(index_t i = 0_sl; i < A.size(); ++i) {
       f(i);
    }
@@ -25,6 +169,14 @@ STRICT_CONSTEXPR_INLINE void apply0(Base& A, F f) {
 
 template <BaseType Base1, BaseType Base2, typename F>
 STRICT_CONSTEXPR_INLINE void apply1(Base1& A1, [[maybe_unused]] const Base2& A2, F f) {
+   if(!std::is_constant_evaluated() && use_parallel<Base1, Base2>(A1.size())) {
+      parallel_for(A1.size(), parallel_grain, [&f](index_t first, index_t last) {
+         for(index_t i = first; i < last; ++i) {
+            f(i);
+         }
+      });
+      return;
+   }
    for(index_t i = 0_sl; i < A1.size(); ++i) {
       f(i);
    }
@@ -33,6 +185,16 @@ STRICT_CONSTEXPR_INLINE void apply1(Base1& A1, [[maybe_unused]] const Base2& A2,
 
 template <typename It, OneDimBaseType Base>
 STRICT_CONSTEXPR_INLINE void copy(It b, It e, Base& A) {
+   if constexpr(std::is_pointer_v<It> && (ContiguousBaseType<Base> || MaybeContiguousBaseType<Base>)) {
+      if constexpr(SameAs<RemoveCVRef<decltype(*b)>, BuiltinTypeOf<Base>>) {
+         if(!std::is_constant_evaluated()) {
+            if(auto p = contiguous_data(A); p != nullptr) {
+               std::memcpy(static_cast<void*>(p), b, sizeof(*b) * static_cast<std::size_t>(e - b));
+               return;
+            }
+         }
+      }
+   }
    for(index_t count = 0_sl; b != e; ++b) {
       A.un(count++) = *b;
    }
@@ -58,8 +220,101 @@ STRICT_CONSTEXPR_INLINE void copy(use::List2D<T> L, Base& A) {
 }
 
 
+// Copies elements in [first, last), packet_size elements at a time if both operands
+// support packets. first should be a multiple of packet_size so that aligned arrays
+// use aligned loads and stores.
+template <BaseType Base1, BaseType Base2>
+STRICT_INLINE void copy_range(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                              index_t first, index_t last) {
+   index_t i = first;
+   if constexpr(PacketCopyable<Base1, Base2>) {
+      constexpr index_t N{packet_size<BuiltinTypeOf<Base2>>()};
+      for(; i + N <= last; i += N) {
+         A2.store_packet(i, A1.load_packet(i));
+      }
+   }
+   for(; i < last; ++i) {
+      A2.un(i) = A1.un(i);
+   }
+}
+
+
+template <BaseType Base>
+STRICT_INLINE void fill_range(ValueTypeOf<Base> val, Base& A, index_t first, index_t last) {
+   if constexpr(!PacketWritable<Base> && MaybeContiguousBaseType<Base>) {
+      if(auto p = contiguous_data(A); p != nullptr) {
+         std::fill(p + first.val(), p + last.val(), val);
+         return;
+      }
+   }
+
+   index_t i = first;
+   if constexpr(PacketWritable<Base>) {
+      constexpr index_t N{packet_size<BuiltinTypeOf<Base>>()};
+      const auto p = broadcast_packet(val);
+      for(; i + N <= last; i += N) {
+         A.store_packet(i, p);
+      }
+   }
+   for(; i < last; ++i) {
+      A.un(i) = val;
+   }
+}
+
+
+// Run time evaluation, which may use packets and multiple threads. Each element is
+// computed by the same operations either way, so results do not depend on the number
+// of threads.
+template <BaseType Base1, BaseType Base2>
+STRICT_INLINE void copy_run_time(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
+   if(copy_index_runs(A1, A2)) {
+      return;
+   }
+
+   if constexpr(ContiguousCopyable<Base1, Base2>) {
+      const auto* p1 = contiguous_data(A1);
+      auto* p2 = contiguous_data(A2);
+      if(p1 != nullptr && p2 != nullptr) {
+         if(use_parallel<Base2, Base1>(A1.size())) {
+            parallel_for(A1.size(), parallel_grain, [p1, p2](index_t first, index_t last) {
+               copy_contiguous(p1 + first.val(), p2 + first.val(), last - first);
+            });
+         } else {
+            copy_contiguous(p1, p2, A1.size());
+         }
+         return;
+      }
+   }
+
+   if constexpr(RangeEvaluable<Base1, Base2>) {
+      if(auto* p2 = contiguous_data(A2); p2 != nullptr) {
+         if(use_parallel<Base2, Base1>(A1.size())) {
+            parallel_for(A1.size(), parallel_grain, [&A1, p2](index_t first, index_t last) {
+               A1.eval_range(p2 + first.val(), first, last);
+            });
+         } else {
+            A1.eval_range(p2, 0_sl, A1.size());
+         }
+         return;
+      }
+   }
+
+   if(use_parallel<Base2, Base1>(A1.size())) {
+      parallel_for(A1.size(), parallel_grain, [&A1, &A2](index_t first, index_t last) {
+         copy_range(A1, A2, first, last);
+      });
+   } else {
+      copy_range(A1, A2, 0_sl, A1.size());
+   }
+}
+
+
 template <BaseType Base1, BaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
+   if(!std::is_constant_evaluated()) {
+      copy_run_time(A1, A2);
+      return;
+   }
    for(index_t i = 0_sl; i < A1.size(); ++i) {
       A2.un(i) = A1.un(i);
    }
@@ -67,15 +322,159 @@ STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT
 
 
 template <ArrayTwoDimType Base1, ArrayTwoDimType Base2>
+   requires(!RowCopyable<Base1, Base2> && !ColContiguousBaseType<Base1>
+            && !ColContiguousBaseType<Base2>)
 STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
+   if(!std::is_constant_evaluated()) {
+      copy_run_time(A1, A2);
+      return;
+   }
    for(index_t i = 0_sl; i < A1.size(); ++i) {
       A2.un(i) = A1.un(i);
    }
 }
 
 
+// Tiles are visited block by block, so that rows of A1 read by transposed tiles are
+// still in cache when the next tiles need them. Must be a multiple of the largest packet size.
+inline constexpr index_t tile_block{64L};
+
+
+// Rows [first, last) of A2 are evaluated tile by tile, where first is a multiple of
+// tile_block. Elements outside of complete tiles are evaluated one by one.
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_INLINE void copy_tile_rows(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                  index_t first, index_t last) {
+   constexpr index_t W{packet_size<BuiltinTypeOf<Base2>>()};
+   const index_t n = A1.cols();
+   const index_t mt = A1.rows() / W * W;
+   const index_t nt = n / W * W;
+   const index_t me = mins(last, mt);
+   auto* p2 = A2.data();
+
+   for(index_t ib = first; ib < me; ib += tile_block) {
+      const index_t ie = mins(ib + tile_block, me);
+      for(index_t jb = 0_sl; jb < nt; jb += tile_block) {
+         const index_t je = mins(jb + tile_block, nt);
+         for(index_t i = ib; i < ie; i += W) {
+            for(index_t j = jb; j < je; j += W) {
+               store_tile(p2 + (i * n + j).val(), n, load_tile(A1, i, j));
+            }
+         }
+      }
+      for(index_t i = ib; i < ie; ++i) {
+         for(index_t j = nt; j < n; ++j) {
+            A2.un(i, j) = A1.un(i, j);
+         }
+      }
+   }
+
+   for(index_t i = maxs(first, mt); i < last; ++i) {
+      for(index_t j = 0_sl; j < n; ++j) {
+         A2.un(i, j) = A1.un(i, j);
+      }
+   }
+}
+
+
+// Rows [first, last) of A2 are evaluated one after another. Rows stored contiguously in
+// both operands are copied by memmove, otherwise elements are written through the pointer
+// to the row of A2 if there is one, which is aligned for arrays with padded rows.
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_INLINE void copy_row_range(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                  index_t first, index_t last) {
+   const index_t n = A1.cols();
+   for(index_t i = first; i < last; ++i) {
+      auto* p2 = row_data(A2, i);
+      if constexpr(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>) {
+         if(const auto* p1 = row_data(A1, i); p1 != nullptr && p2 != nullptr) {
+            copy_contiguous(p1, p2, n);
+            continue;
+         }
+      }
+      if(p2 != nullptr) {
+         for(index_t j = 0_sl; j < n; ++j) {
+            p2[j.val()] = A1.un(i, j);
+         }
+      } else {
+         for(index_t j = 0_sl; j < n; ++j) {
+            A2.un(i, j) = A1.un(i, j);
+         }
+      }
+   }
+}
+
+
+// Columns [first, last) of A2 are evaluated one after another. Columns stored contiguously
+// in both operands are copied by memmove, otherwise elements are written through the
+// pointer to the column of A2.
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_INLINE void copy_col_range(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                  index_t first, index_t last) {
+   const index_t m = A1.rows();
+   for(index_t j = first; j < last; ++j) {
+      auto* p2 = A2.col_data(j);
+      if constexpr(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>) {
+         if(const auto* p1 = col_data(A1, j); p1 != nullptr) {
+            copy_contiguous(p1, p2, m);
+            continue;
+         }
+      }
+      for(index_t i = 0_sl; i < m; ++i) {
+         p2[i.val()] = A1.un(i, j);
+      }
+   }
+}
+
+
+// Two-dimensional objects that can be read in packets or are stored contiguously use
+// row-major order, so that they are evaluated as one-dimensional. Arrays with padded rows
+// are evaluated row by row and column-major arrays column by column. Expressions that
+// cannot, e.g. because they contain transposes, are evaluated tile by tile if possible.
 template <TwoDimBaseType Base1, TwoDimBaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
+   if(!std::is_constant_evaluated()) {
+      if constexpr(ColCopyable<Base1, Base2>) {
+         if(use_parallel<Base2, Base1>(A1.size())) {
+            parallel_for(A1.cols(), 1_sl, [&A1, &A2](index_t first, index_t last) {
+               copy_col_range(A1, A2, first, last);
+            });
+         } else {
+            copy_col_range(A1, A2, 0_sl, A1.cols());
+         }
+         return;
+      } else if constexpr(RowCopyable<Base1, Base2>) {
+         if(use_parallel<Base2, Base1>(A1.size())) {
+            parallel_for(A1.rows(), 1_sl, [&A1, &A2](index_t first, index_t last) {
+               copy_row_range(A1, A2, first, last);
+            });
+         } else {
+            copy_row_range(A1, A2, 0_sl, A1.rows());
+         }
+         return;
+      } else if constexpr(PacketCopyable<Base1, Base2> || ContiguousCopyable<Base1, Base2>) {
+         copy_run_time(A1, A2);
+         return;
+      } else if constexpr(TileCopyable<Base1, Base2>) {
+         if(use_parallel<Base2, Base1>(A1.size())) {
+            parallel_for(A1.rows(), tile_block, [&A1, &A2](index_t first, index_t last) {
+               copy_tile_rows(A1, A2, first, last);
+            });
+         } else {
+            copy_tile_rows(A1, A2, 0_sl, A1.rows());
+         }
+         return;
+      } else if(use_parallel<Base2, Base1>(A1.size())) {
+         parallel_for(A1.rows(), 1_sl, [&A1, &A2](index_t first, index_t last) {
+            for(index_t i = first; i < last; ++i) {
+               for(index_t j = 0_sl; j < A1.cols(); ++j) {
+                  A2.un(i, j) = A1.un(i, j);
+               }
+            }
+         });
+         return;
+      }
+   }
    for(index_t i = 0_sl; i < A1.rows(); ++i) {
       for(index_t j = 0_sl; j < A1.cols(); ++j) {
          A2.un(i, j) = A1.un(i, j);
@@ -87,35 +486,74 @@ STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT
 template <BaseType Base1, BaseType Base2>
 STRICT_CONSTEXPR_INLINE void copyn(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
                                    index_t n) {
-   for(index_t i = 0_sl; i < n; ++i) {
-      A2.un(i) = A1.un(i);
-   }
+   copyn(A1, A2, 0_sl, 0_sl, n);
 }
 
 
 template <BaseType Base1, BaseType Base2>
 STRICT_CONSTEXPR_INLINE void copyn(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
                                    index_t start1, index_t start2, index_t n) {
+   if constexpr(ContiguousCopyable<Base1, Base2>) {
+      if(!std::is_constant_evaluated()) {
+         const auto* p1 = contiguous_data(A1);
+         auto* p2 = contiguous_data(A2);
+         if(p1 != nullptr && p2 != nullptr) {
+            copy_contiguous(p1 + start1.val(), p2 + start2.val(), n);
+            return;
+         }
+      }
+   }
    for(index_t i = 0_sl; i < n; ++i) {
       A2.un(start2 + i) = A1.un(start1 + i);
    }
 }
 
 
+// Copies the block of rows x cols elements starting at (i1, j1) of A1 to (i2, j2) of A2.
+// Returns false if either operand is not stored contiguously.
 template <TwoDimBaseType Base1, TwoDimBaseType Base2>
-STRICT_CONSTEXPR_INLINE void copy_rows(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
-                                       index_t n) {
-   for(index_t i = 0_sl; i < n; ++i) {
-      for(index_t j = 0_sl; j < A1.cols(); ++j) {
-         A2.un(i, j) = A1.un(i, j);
+STRICT_INLINE bool copy_block_contiguous(const Base1& STRICT_RESTRICT A1,
+                                         Base2& STRICT_RESTRICT A2, index_t i1, index_t j1,
+                                         index_t i2, index_t j2, index_t rows, index_t cols) {
+   if constexpr(ContiguousCopyable<Base1, Base2>) {
+      const auto* p1 = contiguous_data(A1);
+      auto* p2 = contiguous_data(A2);
+      if(p1 == nullptr || p2 == nullptr) {
+         return false;
+      }
+      if(rows == 0_sl || cols == 0_sl) {
+         return true;
       }
+      p1 += (i1 * A1.cols() + j1).val();
+      p2 += (i2 * A2.cols() + j2).val();
+      if(cols == A1.cols() && cols == A2.cols()) {
+         copy_contiguous(p1, p2, rows * cols);
+      } else {
+         for(index_t i = 0_sl; i < rows; ++i) {
+            copy_contiguous(p1 + (i * A1.cols()).val(), p2 + (i * A2.cols()).val(), cols);
+         }
+      }
+      return true;
+   } else {
+      return false;
    }
 }
 
 
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_CONSTEXPR_INLINE void copy_rows(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                       index_t n) {
+   copy_rows(A1, A2, 0_sl, 0_sl, n);
+}
+
+
 template <TwoDimBaseType Base1, TwoDimBaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy_rows(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
                                        index_t start1, index_t start2, index_t n) {
+   if(!std::is_constant_evaluated()
+      && copy_block_contiguous(A1, A2, start1, 0_sl, start2, 0_sl, n, A1.cols())) {
+      return;
+   }
    for(index_t i = 0_sl; i < n; ++i) {
       for(index_t j = 0_sl; j < A1.cols(); ++j) {
          A2.un(i + start2, j) = A1.un(i + start1, j);
@@ -127,17 +565,17 @@ STRICT_CONSTEXPR_INLINE void copy_rows(const Base1& STRICT_RESTRICT A1, Base2& S
 template <TwoDimBaseType Base1, TwoDimBaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy_cols(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
                                        index_t n) {
-   for(index_t i = 0_sl; i < A1.rows(); ++i) {
-      for(index_t j = 0_sl; j < n; ++j) {
-         A2.un(i, j) = A1.un(i, j);
-      }
-   }
+   copy_cols(A1, A2, 0_sl, 0_sl, n);
 }
 
 
 template <TwoDimBaseType Base1, TwoDimBaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy_cols(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
                                        index_t start1, index_t start2, index_t n) {
+   if(!std::is_constant_evaluated()
+      && copy_block_contiguous(A1, A2, 0_sl, start1, 0_sl, start2, A1.rows(), n)) {
+      return;
+   }
    for(index_t i = 0_sl; i < A1.rows(); ++i) {
       for(index_t j = 0_sl; j < n; ++j) {
          A2.un(i, j + start2) = A1.un(i, j + start1);
@@ -148,6 +586,44 @@ STRICT_CONSTEXPR_INLINE void copy_cols(const Base1& STRICT_RESTRICT A1, Base2& S
 
 template <BaseType Base>
 STRICT_CONSTEXPR_INLINE void fill(ValueTypeOf<Base> val, Base& A) {
+   if(!std::is_constant_evaluated()) {
+      if(fill_index_runs(val, A)) {
+         return;
+      }
+      if constexpr(RowContiguousBaseType<Base>) {
+         auto fill_rows = [&val, &A](index_t first, index_t last) {
+            for(index_t i = first; i < last; ++i) {
+               std::fill_n(A.row_data(i), A.cols().val(), val);
+            }
+         };
+         if(use_parallel<Base>(A.size())) {
+            parallel_for(A.rows(), 1_sl, fill_rows);
+         } else {
+            fill_rows(0_sl, A.rows());
+         }
+         return;
+      } else if constexpr(ColContiguousBaseType<Base>) {
+         auto fill_cols = [&val, &A](index_t first, index_t last) {
+            for(index_t j = first; j < last; ++j) {
+               std::fill_n(A.col_data(j), A.rows().val(), val);
+            }
+         };
+         if(use_parallel<Base>(A.size())) {
+            parallel_for(A.cols(), 1_sl, fill_cols);
+         } else {
+            fill_cols(0_sl, A.cols());
+         }
+         return;
+      }
+      if(use_parallel<Base>(A.size())) {
+         parallel_for(A.size(), parallel_grain, [&val, &A](index_t first, index_t last) {
+            fill_range(val, A, first, last);
+         });
+      } else {
+         fill_range(val, A, 0_sl, A.size());
+      }
+      return;
+   }
    for(index_t i = 0_sl; i < A.size(); ++i) {
       A.un(i) = val;
    }
@@ -4,6 +4,13 @@
 #pragma once
 
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+#include "../StrictCommon/config.hpp"
+
+
 namespace spp {
 
 
@@ -13,10 +20,32 @@ enum AlignmentFlag { Aligned, Unaligned };
 namespace detail {
 
 
+static_assert(STRICT_ALIGNMENT > 0 && std::has_single_bit(unsigned(STRICT_ALIGNMENT)),
+              "STRICT_ALIGNMENT must be a power of two");
+
+
+// Alignment of arrays with dynamic size. Unaligned arrays have the natural alignment of T.
 template <typename T, AlignmentFlag AF>
 consteval int alignment_of() {
-   // Align to 512 byte boundary for AVX-512.
-   return (AF == Aligned) ? 512 : 0;
+   if constexpr(AF == Aligned) {
+#ifdef STRICT_SIMD_PACKETS
+      return std::max({STRICT_ALIGNMENT, STRICT_SIMD_BYTES, int(alignof(T))});
+#else
+      return std::max(STRICT_ALIGNMENT, int(alignof(T)));
+#endif
+   } else {
+      return int(alignof(T));
+   }
+}
+
+
+// Fixed-size arrays are not aligned beyond the smallest power of two that holds all of their
+// elements. Packets are only loaded from arrays with at least as many elements as a packet,
+// which are still aligned to the packet size.
+template <typename T, long int N, AlignmentFlag AF>
+consteval int fixed_alignment_of() {
+   const auto bytes = std::bit_ceil(std::size_t(N) * sizeof(T));
+   return std::max(int(alignof(T)), std::min(alignment_of<T, AF>(), int(bytes)));
 }
 
 
@@ -24,4 +53,3 @@ consteval int alignment_of() {
 
 
 }  // namespace spp
-
@@ -4,6 +4,8 @@
 #pragma once
 
 
+#include <cstddef>
+
 #include "../StrictCommon/config.hpp"
 #include "../StrictCommon/strict_literals.hpp"
 #include "../StrictCommon/strict_traits.hpp"
@@ -61,6 +63,40 @@ STRICT_NODISCARD_CONSTEXPR bool same_dimension_b() {
 }
 
 
+namespace detail {
+
+
+// Returns true if A is an array other than B. Arrays do not share storage, so writing
+// to B cannot change A, whereas slices and expressions may refer to B.
+template <BaseType Base1, BaseType Base2>
+STRICT_NODISCARD_CONSTEXPR bool distinct_array(const Base1& A, const Base2& B) {
+   if constexpr(ArrayType<Base1>) {
+      return A.size() == 0_sl || B.size() == 0_sl
+          || static_cast<const void*>(&A.un(0)) != static_cast<const void*>(&B.un(0));
+   } else {
+      return false;
+   }
+}
+
+
+// Returns true if m x n elements of size bytes each fit in the given number of bytes.
+// Unlike m * n * size <= bytes, the check cannot overflow.
+STRICT_NODISCARD_CONSTEXPR_INLINE bool fits_in_bytes(index_t m, index_t n, std::size_t size,
+                                                     std::size_t bytes) {
+   if(m < 0_sl || n < 0_sl) {
+      return false;
+   }
+   if(m == 0_sl || n == 0_sl) {
+      return true;
+   }
+   const std::size_t count = bytes / size;
+   return std::size_t(m.val()) <= count && std::size_t(n.val()) <= count / std::size_t(m.val());
+}
+
+
+}  // namespace detail
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <BaseType Base1, BaseType Base2>
    requires(same_dimension_b<Base1, Base2>())
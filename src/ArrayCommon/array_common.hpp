@@ -8,7 +8,15 @@
 #include "alignment.hpp"
 #include "array_auxiliary.hpp"
 #include "array_traits.hpp"
+#include "gather.hpp"
 #include "index_helper.hpp"
+#include "layout.hpp"
+#include "memory_resource.hpp"
+#include "packet.hpp"
+#include "page_resource.hpp"
+#include "parallel.hpp"
+#include "reduction.hpp"
+#include "tile.hpp"
 #include "use.hpp"
 #include "valid.hpp"
 
@@ -62,6 +62,12 @@ struct ConstSliceBase {};
 template <typename T> concept ConstSliceBaseType = BaseType<T> && BaseOf<ConstSliceBase, T>;
 
 
+// Expressions with internal state, such as random number generators,
+// which must be evaluated sequentially.
+struct SequentialBase {};
+template <typename T> concept SequentialBaseType = BaseType<T> && BaseOf<SequentialBase, T>;
+
+
 // Objects of type Array or slices of Array with non-constant semantics. Expression templates are
 // excluded since they return by value and thus std::is_lvalue_reference_v evaluates to false.
 template <typename T> concept NonConstBaseType
@@ -225,6 +231,39 @@ template <typename T> concept ArrayTwoDimIntegerTypeRvalue = RvalueOf<T, ArrayTw
 template <typename T> concept ArrayTwoDimFloatingTypeRvalue = RvalueOf<T, ArrayTwoDimFloatingType<RemoveRef<T>>>;
 
 
+// Two-dimensional objects stored in column-major order. Column j starts at
+// col_data(j) = col_data(0) + j * rows().
+template <typename T> concept ColContiguousBaseType
+    = TwoDimBaseType<T> && requires(const T& A, ImplicitInt j) {
+         { A.col_data(j) } -> SameAs<const ValueTypeOf<T>*>;
+      };
+
+
+// Objects whose elements are always stored contiguously in row-major order, e.g. arrays and
+// attached pointers. Column-major arrays provide data() for interoperability, but are not
+// included.
+template <typename T> concept ContiguousBaseType
+    = BaseType<T> && !ColContiguousBaseType<T> && requires(const T& A) {
+         { A.data() } -> SameAs<const ValueTypeOf<T>*>;
+      };
+
+
+// Objects whose elements are stored contiguously depending on run time parameters, e.g.
+// slices by seqN with unit stride. contiguous_data() returns nullptr otherwise.
+template <typename T> concept MaybeContiguousBaseType = BaseType<T> && requires(const T& A) {
+   { A.contiguous_data() } -> SameAs<const ValueTypeOf<T>*>;
+};
+
+
+// Two-dimensional objects whose rows are stored contiguously, but not next to each other,
+// e.g. arrays with padded rows. Row i starts at row_data(i) = row_data(0) + i * leading_dim().
+template <typename T> concept RowContiguousBaseType
+    = TwoDimBaseType<T> && requires(const T& A, ImplicitInt i) {
+         { A.row_data(i) } -> SameAs<const ValueTypeOf<T>*>;
+         { A.leading_dim() } -> SameAs<index_t>;
+      };
+
+
 template <typename T> concept PointerConvertibleLvalue
     = std::is_lvalue_reference_v<T> && requires(RemoveRef<T> p) {
          { p } -> std::convertible_to<std::add_pointer_t<decltype(p[0])>>;
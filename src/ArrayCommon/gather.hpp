@@ -0,0 +1,190 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_literals.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "alignment.hpp"
+#include "array_traits.hpp"
+#include "packet.hpp"
+
+#if defined STRICT_SIMD_PACKETS && (defined __AVX2__ || defined __AVX512F__)
+#include <immintrin.h>
+#endif
+
+
+namespace spp::detail {
+
+
+// Describes elements data[index[0]], ..., data[index[size - 1]] of a slice by an index
+// vector. data is nullptr if the sliced object is not stored contiguously.
+template <typename Ptr>
+struct IndexedData {
+   Ptr data;
+   const long int* index;
+   index_t size;
+};
+
+
+// Slices by index vectors, which provide indexed_data().
+template <typename T> concept IndexedBaseType = BaseType<T> && requires(const T& A) {
+   A.indexed_data();
+};
+
+
+// Runs of consecutive indexes are copied block by block only if they are at least this
+// long on average, otherwise gathering is faster.
+inline constexpr long int min_average_run{16L};
+
+
+STRICT_INLINE bool long_runs(const long int* index, index_t n) {
+   long int nruns = n.val() == 0 ? 0 : 1;
+   for(long int k = 1; k < n.val(); ++k) {
+      nruns += index[k] != index[k - 1] + 1;
+   }
+   return nruns * min_average_run <= n.val();
+}
+
+
+// Calls f(first, i, size) for every maximal run, so that positions [first, first + size)
+// of the index vector refer to elements [i, i + size). Runs are visited in order.
+template <typename F>
+STRICT_INLINE void for_each_run(const long int* index, index_t n, F f) {
+   for(long int k = 0; k < n.val();) {
+      long int l = k + 1;
+      while(l < n.val() && index[l] == index[l - 1] + 1) {
+         ++l;
+      }
+      f(k, index[k], l - k);
+      k = l;
+   }
+}
+
+
+template <typename T>
+struct HardwareGather {
+   static constexpr bool enabled = false;
+};
+
+
+// Scatter instructions are not used since storing lane by lane was measured to be faster.
+#if defined STRICT_SIMD_PACKETS && STRICT_SIMD_BYTES == 64
+template <>
+struct HardwareGather<double> {
+   static constexpr bool enabled = true;
+
+   static __m512d load(const double* p, const long int* index) {
+      return _mm512_i64gather_pd(_mm512_loadu_si512(index), p, 8);
+   }
+};
+
+
+// Each instruction reads half of the lanes since indexes are 64-bit.
+template <>
+struct HardwareGather<float> {
+   static constexpr bool enabled = true;
+   using Half = __m256;
+
+   static Half load(const float* p, const long int* index) {
+      return _mm512_i64gather_ps(_mm512_loadu_si512(index), p, 4);
+   }
+};
+
+
+#elif defined STRICT_SIMD_PACKETS && STRICT_SIMD_BYTES == 32 && defined __AVX2__
+template <>
+struct HardwareGather<double> {
+   static constexpr bool enabled = true;
+
+   static __m256d load(const double* p, const long int* index) {
+      return _mm256_i64gather_pd(p, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)),
+                                 8);
+   }
+};
+
+
+template <>
+struct HardwareGather<float> {
+   static constexpr bool enabled = true;
+   using Half = __m128;
+
+   static Half load(const float* p, const long int* index) {
+      return _mm256_i64gather_ps(p, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)),
+                                 4);
+   }
+};
+#endif
+
+
+template <typename T> concept HalfGather = requires { typename HardwareGather<T>::Half; };
+
+
+template <PacketBuiltin T, typename H, std::size_t... I>
+STRICT_NODISCARD_INLINE Packet<T> concat_halves(H x, H y, std::index_sequence<I...>) {
+   return std::bit_cast<Packet<T>>(__builtin_shufflevector(x, y, I...));
+}
+
+
+template <long int W>
+STRICT_INLINE bool consecutive_indexes(const long int* index) {
+   for(long int l = 1; l < W; ++l) {
+      if(index[l] != index[0] + l) {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+// Reads p[index[0]], ..., p[index[W - 1]], where W is the number of elements in a packet.
+// Consecutive indexes are read by a single load.
+template <PacketBuiltin T>
+STRICT_NODISCARD_INLINE Packet<T> gather_packet(const Strict<T>* p, const long int* index) {
+   constexpr long int W = packet_size<T>();
+   if(consecutive_indexes<W>(index)) {
+      return load_packet<Unaligned>(p + index[0]);
+   }
+
+   if constexpr(HardwareGather<T>::enabled) {
+      const T* q = reinterpret_cast<const T*>(p);
+      if constexpr(HalfGather<T>) {
+         return concat_halves<T>(HardwareGather<T>::load(q, index),
+                                 HardwareGather<T>::load(q, index + W / 2),
+                                 std::make_index_sequence<std::size_t(W)>{});
+      } else {
+         return std::bit_cast<Packet<T>>(HardwareGather<T>::load(q, index));
+      }
+   } else {
+      Packet<T> x;
+      for(long int l = 0; l < W; ++l) {
+         x[l] = p[index[l]].val();
+      }
+      return x;
+   }
+}
+
+
+// Writes p[index[0]], ..., p[index[W - 1]] in this order, so that the last lane wins if
+// an index is repeated. Consecutive indexes are written by a single store.
+template <PacketBuiltin T>
+STRICT_INLINE void scatter_packet(Strict<T>* p, const long int* index, Packet<T> x) {
+   constexpr long int W = packet_size<T>();
+   if(consecutive_indexes<W>(index)) {
+      store_packet<Unaligned>(p + index[0], x);
+      return;
+   }
+   for(long int l = 0; l < W; ++l) {
+      p[index[l]] = Strict<T>{x[l]};
+   }
+}
+
+
+}  // namespace spp::detail
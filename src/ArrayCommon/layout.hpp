@@ -0,0 +1,15 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+namespace spp {
+
+
+// Order in which elements of two-dimensional arrays are stored. Indexing, iteration and
+// one-dimensional views use row-major order regardless of the layout.
+enum Layout { RowMajor, ColMajor };
+
+
+}  // namespace spp
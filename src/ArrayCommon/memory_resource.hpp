@@ -0,0 +1,66 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <memory_resource>
+#include <type_traits>
+
+#include "../StrictCommon/config.hpp"
+
+
+namespace spp {
+
+
+namespace detail {
+
+
+inline std::pmr::memory_resource*& memory_resource_ref() {
+   static thread_local std::pmr::memory_resource* resource{};
+   return resource;
+}
+
+
+// Arrays are never allocated from a memory resource at compile time.
+STRICT_CONSTEXPR std::pmr::memory_resource* current_memory_resource() {
+   if(std::is_constant_evaluated()) {
+      return nullptr;
+   }
+   return memory_resource_ref();
+}
+
+
+}  // namespace detail
+
+
+// Arrays constructed on the calling thread while a scope is alive allocate their elements
+// from resource, e.g. std::pmr::monotonic_buffer_resource for scratch arrays that are
+// released all at once. An array keeps allocating from the resource it was constructed
+// with when it grows, so the resource must outlive the array. Scopes can be nested; the
+// previous resource is restored on destruction. A null resource selects operator new.
+class STRICT_NODISCARD ScopedMemoryResource {
+public:
+   explicit ScopedMemoryResource(std::pmr::memory_resource* resource)
+       : previous_{detail::memory_resource_ref()} {
+      detail::memory_resource_ref() = resource;
+   }
+
+   ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+   ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+
+   ~ScopedMemoryResource() {
+      detail::memory_resource_ref() = previous_;
+   }
+
+private:
+   std::pmr::memory_resource* previous_;
+};
+
+
+inline std::pmr::memory_resource* memory_resource() {
+   return detail::memory_resource_ref();
+}
+
+
+}  // namespace spp
@@ -0,0 +1,167 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "alignment.hpp"
+#include "array_traits.hpp"
+
+
+namespace spp::detail {
+
+
+struct NoPacket {};
+
+
+template <typename T>
+struct PacketTraits {
+   static constexpr bool enabled = false;
+   using type = NoPacket;
+};
+
+
+#ifdef STRICT_SIMD_PACKETS
+template <>
+struct PacketTraits<float> {
+   static constexpr bool enabled = true;
+   typedef float type __attribute__((vector_size(STRICT_SIMD_BYTES), __may_alias__));
+};
+
+
+template <>
+struct PacketTraits<double> {
+   static constexpr bool enabled = true;
+   typedef double type __attribute__((vector_size(STRICT_SIMD_BYTES), __may_alias__));
+};
+#endif
+
+
+// Only float and double are evaluated in packets so that results are bitwise identical
+// to element by element evaluation. Integer division is checked in debug mode,
+// which packets would bypass.
+template <typename T> concept PacketBuiltin = PacketTraits<T>::enabled;
+
+
+// Not constrained so that it can appear in member declarations of all array types.
+template <typename T>
+using Packet = PacketTraits<T>::type;
+
+
+template <PacketBuiltin T>
+consteval long int packet_size() {
+   return long(sizeof(Packet<T>) / sizeof(T));
+}
+
+
+template <PacketBuiltin T, std::size_t... I>
+STRICT_NODISCARD_INLINE Packet<T> broadcast_packet(Strict<T> x, std::index_sequence<I...>) {
+   return Packet<T>{((void)I, x.val())...};
+}
+
+
+// Lanes are initialized directly rather than by adding x to a zero packet, which would
+// turn -0 into +0 and cost an addition.
+template <PacketBuiltin T>
+STRICT_NODISCARD_INLINE Packet<T> broadcast_packet(Strict<T> x) {
+   return broadcast_packet(x, std::make_index_sequence<std::size_t(packet_size<T>())>{});
+}
+
+
+// Aligned loads and stores require p to be aligned to sizeof(Packet<T>), which is
+// satisfied for the Aligned flag as long as the index is a multiple of packet_size<T>().
+template <AlignmentFlag AF, PacketBuiltin T>
+STRICT_NODISCARD_INLINE Packet<T> load_packet(const Strict<T>* p) {
+   if constexpr(AF == Aligned) {
+      return *reinterpret_cast<const Packet<T>*>(p);
+   } else {
+      Packet<T> x;
+      std::memcpy(&x, p, sizeof(Packet<T>));
+      return x;
+   }
+}
+
+
+template <AlignmentFlag AF, PacketBuiltin T>
+STRICT_INLINE void store_packet(Strict<T>* p, Packet<T> x) {
+   if constexpr(AF == Aligned) {
+      *reinterpret_cast<Packet<T>*>(p) = x;
+   } else {
+      std::memcpy(static_cast<void*>(p), &x, sizeof(Packet<T>));
+   }
+}
+
+
+// Lanes of x in reverse order.
+template <PacketBuiltin T, std::size_t... I>
+STRICT_NODISCARD_INLINE Packet<T> reverse_packet(Packet<T> x, std::index_sequence<I...>) {
+   return __builtin_shufflevector(x, x, (sizeof...(I) - 1 - I)...);
+}
+
+
+// Even lanes of x followed by odd lanes of y, where y starts one element before the
+// second half of the elements that are read, so that no element past them is accessed.
+template <PacketBuiltin T, std::size_t... I>
+STRICT_NODISCARD_INLINE Packet<T> even_packet(Packet<T> x, Packet<T> y, std::index_sequence<I...>) {
+   return __builtin_shufflevector(x, y, (I < sizeof...(I) / 2 ? 2 * I : 2 * I + 1)...);
+}
+
+
+// Reads p[0], p[S], ..., p[(W - 1) * S], where W is the number of elements in a packet.
+template <long int S, PacketBuiltin T>
+STRICT_NODISCARD_INLINE Packet<T> load_packet_strided(const Strict<T>* p) {
+   constexpr long int W = packet_size<T>();
+   using Lanes = std::make_index_sequence<std::size_t(W)>;
+   if constexpr(S == -1) {
+      return reverse_packet<T>(load_packet<Unaligned>(p - (W - 1)), Lanes{});
+   } else {
+      static_assert(S == 2);
+      return even_packet<T>(load_packet<Unaligned>(p), load_packet<Unaligned>(p + (W - 1)),
+                            Lanes{});
+   }
+}
+
+
+// Writes p[0], p[S], ..., p[(W - 1) * S]. Elements in between are not accessed.
+template <long int S, PacketBuiltin T>
+STRICT_INLINE void store_packet_strided(Strict<T>* p, Packet<T> x) {
+   constexpr long int W = packet_size<T>();
+   if constexpr(S == -1) {
+      store_packet<Unaligned>(p - (W - 1), reverse_packet<T>(x, std::make_index_sequence<std::size_t(W)>{}));
+   } else {
+      for(long int l = 0; l < W; ++l) {
+         p[l * S] = Strict<T>{x[l]};
+      }
+   }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Objects that can be read in packets, e.g. arrays and expressions of arrays.
+template <typename T> concept PacketReadable
+    = BaseType<T> && PacketBuiltin<BuiltinTypeOf<T>> && requires(const T& A, ImplicitInt i) {
+         { A.load_packet(i) } -> SameAs<Packet<BuiltinTypeOf<T>>>;
+      };
+
+
+// Objects that can be written in packets, i.e. arrays that own data.
+template <typename T> concept PacketWritable
+    = PacketReadable<T> && requires(T& A, ImplicitInt i, Packet<BuiltinTypeOf<T>> x) {
+         A.store_packet(i, x);
+      };
+
+
+template <typename Base1, typename Base2> concept PacketCopyable
+    = PacketReadable<Base1> && PacketWritable<Base2>
+   && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>;
+
+
+}  // namespace spp::detail
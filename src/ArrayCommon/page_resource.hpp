@@ -0,0 +1,159 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+
+namespace spp {
+
+
+enum class PagePolicy { Default, TransparentHuge, ExplicitHuge };
+
+
+// Interleave spreads pages round-robin over the nodes allowed for the process. Local places
+// pages on the node of the thread that first touches them, regardless of the process policy.
+enum class NumaPolicy { Default, Interleave, Local };
+
+
+// Memory resource that maps allocations of at least threshold bytes directly with mmap, so
+// that the page size and NUMA placement can be controlled. Smaller allocations are passed to
+// upstream. Huge page mappings are aligned to and rounded up to the huge page size.
+// ExplicitHuge requires pages reserved in the hugetlb pool and falls back to transparent huge
+// pages if none are available. NUMA policies are hints and are ignored if the kernel does not
+// support them. Arrays are allocated from the resource inside of a ScopedMemoryResource.
+class PageResource : public std::pmr::memory_resource {
+public:
+   static constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+   explicit PageResource(PagePolicy pages,
+                         NumaPolicy numa = NumaPolicy::Default,
+                         std::size_t threshold = huge_page_size,
+                         std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+       : pages_{pages},
+         numa_{numa},
+         threshold_{threshold},
+         page_size_{std::size_t(sysconf(_SC_PAGESIZE))},
+         upstream_{upstream} {
+   }
+
+   PagePolicy pages() const {
+      return pages_;
+   }
+
+   NumaPolicy numa() const {
+      return numa_;
+   }
+
+private:
+   PagePolicy pages_;
+   NumaPolicy numa_;
+   std::size_t threshold_;
+   std::size_t page_size_;
+   std::pmr::memory_resource* upstream_;
+
+   bool mapped(std::size_t bytes, std::size_t alignment) const {
+      return bytes >= threshold_ && bytes > 0 && alignment <= page_size_;
+   }
+
+   bool huge() const {
+      return pages_ != PagePolicy::Default;
+   }
+
+   std::size_t mapped_size(std::size_t bytes) const {
+      const std::size_t unit = huge() ? huge_page_size : page_size_;
+      return (bytes + unit - 1) / unit * unit;
+   }
+
+   static void* map(std::size_t len, int flags = 0) {
+      void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags,
+                     -1, 0);
+      return p == MAP_FAILED ? nullptr : p;
+   }
+
+   // Maps len + huge_page_size bytes and unmaps the parts before and after the first
+   // huge page boundary.
+   static void* map_huge_aligned(std::size_t len) {
+      auto* raw = static_cast<char*>(map(len + huge_page_size));
+      if(raw == nullptr) {
+         return nullptr;
+      }
+      const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+      auto* p = raw + ((huge_page_size - addr % huge_page_size) % huge_page_size);
+      if(p != raw) {
+         munmap(raw, std::size_t(p - raw));
+      }
+      if(std::size_t tail = std::size_t(raw + huge_page_size - p); tail != 0) {
+         munmap(p + len, tail);
+      }
+      return p;
+   }
+
+   void set_numa_policy(void* p, std::size_t len) const {
+      constexpr std::size_t nwords = 16;
+      constexpr unsigned long nbits = nwords * 64;
+      if(numa_ == NumaPolicy::Interleave) {
+         unsigned long mask[nwords]{};
+         if(syscall(SYS_get_mempolicy, nullptr, mask, nbits, nullptr, MPOL_F_MEMS_ALLOWED) == 0) {
+            // The kernel reads maxnode - 1 bits of the mask.
+            syscall(SYS_mbind, p, len, MPOL_INTERLEAVE, mask, nbits + 1, 0);
+         }
+      } else if(numa_ == NumaPolicy::Local) {
+         syscall(SYS_mbind, p, len, MPOL_LOCAL, nullptr, 0, 0);
+      }
+   }
+
+   void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+      if(!mapped(bytes, alignment)) {
+         return upstream_->allocate(bytes, alignment);
+      }
+
+      const std::size_t len = mapped_size(bytes);
+      void* p = nullptr;
+      if(pages_ == PagePolicy::ExplicitHuge) {
+         p = map(len, MAP_HUGETLB);
+      }
+      if(p == nullptr && huge()) {
+         p = map_huge_aligned(len);
+         if(p != nullptr) {
+            madvise(p, len, MADV_HUGEPAGE);
+         }
+      } else if(p == nullptr) {
+         p = map(len);
+      }
+      if(p == nullptr) {
+         throw std::bad_alloc{};
+      }
+
+      // Pages are not populated until touched, so the policy applies to all of them.
+      this->set_numa_policy(p, len);
+      return p;
+   }
+
+   void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+      if(!mapped(bytes, alignment)) {
+         upstream_->deallocate(p, bytes, alignment);
+      } else {
+         munmap(p, mapped_size(bytes));
+      }
+   }
+
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+   }
+};
+
+
+}  // namespace spp
+#endif
@@ -0,0 +1,276 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#ifdef STRICT_PARALLEL
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif
+
+#include "../StrictCommon/strict_common.hpp"
+#include "array_traits.hpp"
+
+
+namespace spp::detail {
+
+
+#ifdef STRICT_PARALLEL
+// Chunk k is always executed by thread k % size(), where the calling thread is thread 0.
+// Static assignment keeps memory touched by a thread the same across calls, e.g. when
+// an array is initialized and later updated. Calls from inside of a parallel region,
+// or while the pool is busy with another caller, are executed serially.
+class ThreadPool {
+public:
+   static ThreadPool& instance() {
+      static ThreadPool pool(std::max(1L, long(std::thread::hardware_concurrency())));
+      return pool;
+   }
+
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+
+   ~ThreadPool() {
+      this->stop();
+   }
+
+   long int size() const {
+      return long(workers_.size()) + 1;
+   }
+
+   void resize(long int nthreads) {
+      std::lock_guard run_lock{run_mutex_};
+      this->stop();
+      this->start(nthreads);
+   }
+
+   void run(long int nchunks, const std::function<void(long int)>& f) {
+      std::unique_lock run_lock{run_mutex_, std::try_to_lock};
+      if(!run_lock.owns_lock() || in_region_ || workers_.empty() || nchunks < 2) {
+         for(long int k = 0; k < nchunks; ++k) {
+            f(k);
+         }
+         return;
+      }
+
+      {
+         std::lock_guard lock{mutex_};
+         job_ = &f;
+         nchunks_ = nchunks;
+         pending_ = workers_.size();
+         ++generation_;
+      }
+      cv_.notify_all();
+      this->work(0);
+
+      std::unique_lock lock{mutex_};
+      done_cv_.wait(lock, [this] { return pending_ == 0; });
+      job_ = nullptr;
+      if(error_) {
+         std::rethrow_exception(std::exchange(error_, nullptr));
+      }
+   }
+
+private:
+   explicit ThreadPool(long int nthreads) {
+      this->start(nthreads);
+   }
+
+   void start(long int nthreads) {
+      stop_ = false;
+      // Generation is passed by value since workers may start after the first job is posted.
+      for(long int t = 1; t < nthreads; ++t) {
+         workers_.emplace_back([this, t, seen = generation_] { this->loop(t, seen); });
+      }
+   }
+
+   void stop() {
+      {
+         std::lock_guard lock{mutex_};
+         stop_ = true;
+      }
+      cv_.notify_all();
+      for(auto& w : workers_) {
+         w.join();
+      }
+      workers_.clear();
+   }
+
+   void work(long int t) {
+      in_region_ = true;
+      for(long int k = t; k < nchunks_; k += this->size()) {
+         try {
+            (*job_)(k);
+         } catch(...) {
+            std::lock_guard lock{mutex_};
+            if(!error_) {
+               error_ = std::current_exception();
+            }
+         }
+      }
+      in_region_ = false;
+   }
+
+   void loop(long int t, std::size_t seen) {
+      while(true) {
+         {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+            if(stop_) {
+               return;
+            }
+            seen = generation_;
+         }
+
+         this->work(t);
+
+         std::lock_guard lock{mutex_};
+         if(--pending_ == 0) {
+            done_cv_.notify_one();
+         }
+      }
+   }
+
+   std::vector<std::thread> workers_;
+   std::mutex run_mutex_;
+   std::mutex mutex_;
+   std::condition_variable cv_;
+   std::condition_variable done_cv_;
+
+   const std::function<void(long int)>* job_{};
+   long int nchunks_{};
+   std::size_t pending_{};
+   std::size_t generation_{};
+   bool stop_{};
+   std::exception_ptr error_;
+
+   static inline thread_local bool in_region_{};
+};
+
+
+inline index_t& parallel_threshold_ref() {
+   static index_t threshold{1L << 16};
+   return threshold;
+}
+#endif
+
+
+// Returns true if reading n elements of Sources, e.g. to compute a reduction, should be split
+// across threads.
+template <typename... Sources>
+STRICT_INLINE bool use_parallel_read([[maybe_unused]] index_t n) {
+#ifdef STRICT_PARALLEL
+   if constexpr(!(SequentialBaseType<Sources> || ...)) {
+      return n >= parallel_threshold_ref() && ThreadPool::instance().size() > 1;
+   } else {
+      return false;
+   }
+#else
+   return false;
+#endif
+}
+
+
+// Returns true if writing n elements of Dest, which are read from Sources, should be split
+// across threads. Only arrays that own data are written in parallel since slices by index
+// vectors may refer to the same element more than once.
+template <typename Dest, typename... Sources>
+STRICT_INLINE bool use_parallel([[maybe_unused]] index_t n) {
+   if constexpr(ArrayType<Dest>) {
+      return use_parallel_read<Sources...>(n);
+   } else {
+      return false;
+   }
+}
+
+
+// Chunks of one-dimensional ranges are multiples of the largest packet size so that
+// aligned arrays remain aligned at the beginning of each chunk.
+inline constexpr index_t parallel_grain{64L};
+
+
+// Splits [0, n) into contiguous chunks and calls f(first, last) for each of them.
+// Chunk boundaries, except for the last one, are multiples of grain.
+template <typename F>
+STRICT_INLINE void parallel_for(index_t n, [[maybe_unused]] index_t grain, F f) {
+#ifdef STRICT_PARALLEL
+   const index_t nthreads{ThreadPool::instance().size()};
+   const index_t per_thread = (n + nthreads - 1_sl) / nthreads;
+   const index_t chunk = maxs(grain, (per_thread + grain - 1_sl) / grain * grain);
+   const index_t nchunks = (n + chunk - 1_sl) / chunk;
+
+   ThreadPool::instance().run(nchunks.val(), [&](long int k) {
+      const index_t first = chunk * index_t{k};
+      f(first, mins(first + chunk, n));
+   });
+#else
+   f(0_sl, n);
+#endif
+}
+
+
+// Number of chunks that reading n elements of Sources, or n bytes of text, is split into.
+// Every thread gets exactly one chunk.
+template <typename... Sources>
+STRICT_INLINE long int parallel_read_chunks([[maybe_unused]] index_t n) {
+#ifdef STRICT_PARALLEL
+   return use_parallel_read<Sources...>(n) ? ThreadPool::instance().size() : 1L;
+#else
+   return 1L;
+#endif
+}
+
+
+// Calls f(k) for every chunk k in [0, nchunks).
+template <typename F>
+STRICT_INLINE void parallel_run(long int nchunks, F f) {
+#ifdef STRICT_PARALLEL
+   ThreadPool::instance().run(nchunks, f);
+#else
+   for(long int k = 0; k < nchunks; ++k) {
+      f(k);
+   }
+#endif
+}
+
+
+}  // namespace spp::detail
+
+
+#ifdef STRICT_PARALLEL
+namespace spp {
+
+
+inline void set_parallel_threads(ImplicitInt nthreads) {
+   ASSERT_STRICT_ALWAYS(nthreads.get() > 0_sl);
+   detail::ThreadPool::instance().resize(nthreads.get().val());
+}
+
+
+inline index_t parallel_threads() {
+   return index_t{detail::ThreadPool::instance().size()};
+}
+
+
+// Operations on fewer elements than the threshold are executed serially.
+inline void set_parallel_threshold(ImplicitInt n) {
+   ASSERT_STRICT_ALWAYS(n.get() > -1_sl);
+   detail::parallel_threshold_ref() = n.get();
+}
+
+
+inline index_t parallel_threshold() {
+   return detail::parallel_threshold_ref();
+}
+
+
+}  // namespace spp
+#endif
@@ -0,0 +1,230 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_literals.hpp"
+#include "../StrictCommon/strict_math.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "array_traits.hpp"
+#include "packet.hpp"
+#include "parallel.hpp"
+
+
+// Reductions evaluate elements in a fixed order that does not depend on the number of threads,
+// on whether packets are enabled, or on timing, so the result is reproducible for a given
+// size. The order differs from the left to right evaluation, which is allowed by the
+// following reassociation contract:
+//
+// 1. Elements are split into blocks of reduce_block elements; the last block may be shorter.
+// 2. In each block of at least reduce_lanes elements, accumulator j starts from element j and
+//    accumulates elements j + reduce_lanes, j + 2 * reduce_lanes, ... from left to right,
+//    including the remaining elements at the end of the block. The accumulators are then
+//    combined pairwise: j with j + reduce_lanes / 2, then j with j + reduce_lanes / 4, etc.
+//    Shorter blocks are accumulated from left to right.
+// 3. Results of the blocks are combined by a balanced binary tree: the blocks are split in
+//    half, where the left half has the smaller number of blocks, and each half is reduced
+//    in the same way.
+//
+// Integer sums and products are not affected by reassociation unless they overflow.
+// The same holds for min and max, except that the element returned in presence of
+// NaN may differ from the left to right evaluation. Bitwise reproducibility of floating-point
+// results also requires that the compiler does not contract multiplications and additions,
+// e.g. -ffp-contract=off, since contraction may differ in packet and scalar code.
+namespace spp::detail {
+
+
+inline constexpr std::size_t reduce_lanes = 32;
+inline constexpr long int reduce_block = 1L << 13;
+static_assert(reduce_block % long(reduce_lanes) == 0);
+
+
+struct ReduceSum {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> operator()(Strict<T> acc, Strict<T> x) const {
+      return acc + x;
+   }
+
+   STRICT_NODISCARD_INLINE auto packet(auto acc, auto x) const {
+      return acc + x;
+   }
+};
+
+
+struct ReduceProd {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> operator()(Strict<T> acc, Strict<T> x) const {
+      return acc * x;
+   }
+
+   STRICT_NODISCARD_INLINE auto packet(auto acc, auto x) const {
+      return acc * x;
+   }
+};
+
+
+struct ReduceMin {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> operator()(Strict<T> acc, Strict<T> x) const {
+      return mins(x, acc);
+   }
+
+   STRICT_NODISCARD_INLINE auto packet(auto acc, auto x) const {
+      return x < acc ? x : acc;
+   }
+};
+
+
+struct ReduceMax {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> operator()(Strict<T> acc, Strict<T> x) const {
+      return maxs(x, acc);
+   }
+
+   STRICT_NODISCARD_INLINE auto packet(auto acc, auto x) const {
+      return x > acc ? x : acc;
+   }
+};
+
+
+template <typename Base, typename Op> concept PacketReducible
+    = PacketReadable<Base> && requires(const Op& op, Packet<BuiltinTypeOf<Base>> x) {
+         { op.packet(x, x) } -> SameAs<Packet<BuiltinTypeOf<Base>>>;
+      };
+
+
+template <typename T, typename Op>
+STRICT_CONSTEXPR_INLINE T reduce_lanes_tree(std::array<T, reduce_lanes>& acc, Op op) {
+   for(std::size_t h = reduce_lanes / 2; h > 0; h /= 2) {
+      for(std::size_t j = 0; j < h; ++j) {
+         acc[j] = op(acc[j], acc[j + h]);
+      }
+   }
+   return acc[0];
+}
+
+
+// Accumulators are kept in packets, lane l of packet u holding accumulator u * W + l,
+// where W is the number of elements in a packet. Hence, the result is bitwise identical
+// to reduce_range_scalar.
+template <typename Base, typename Op>
+   requires PacketReducible<Base, Op>
+STRICT_INLINE ValueTypeOf<Base> reduce_range_packet(const Base& A, index_t first, index_t last,
+                                                   Op op) {
+   using T = BuiltinTypeOf<Base>;
+   constexpr auto W = std::size_t(packet_size<T>());
+   constexpr auto U = reduce_lanes / W;
+   static_assert(reduce_lanes % W == 0);
+
+   Packet<T> pacc[U];
+   for(std::size_t u = 0; u < U; ++u) {
+      pacc[u] = A.load_packet(first + to_index_t(u * W));
+   }
+
+   const index_t lanes = to_index_t(reduce_lanes);
+   index_t i = first + lanes;
+   for(; i + lanes <= last; i += lanes) {
+      for(std::size_t u = 0; u < U; ++u) {
+         pacc[u] = op.packet(pacc[u], A.load_packet(i + to_index_t(u * W)));
+      }
+   }
+
+   std::array<ValueTypeOf<Base>, reduce_lanes> acc;
+   for(std::size_t u = 0; u < U; ++u) {
+      store_packet<Unaligned>(acc.data() + u * W, pacc[u]);
+   }
+   for(std::size_t j = 0; i < last; ++i, ++j) {
+      acc[j] = op(acc[j], A.un(i));
+   }
+   return reduce_lanes_tree(acc, op);
+}
+
+
+template <typename Base, typename Op>
+STRICT_CONSTEXPR ValueTypeOf<Base> reduce_range_scalar(const Base& A, index_t first, index_t last,
+                                                      Op op) {
+   std::array<ValueTypeOf<Base>, reduce_lanes> acc;
+   for(std::size_t j = 0; j < reduce_lanes; ++j) {
+      acc[j] = A.un(first + to_index_t(j));
+   }
+
+   const index_t lanes = to_index_t(reduce_lanes);
+   index_t i = first + lanes;
+   for(; i + lanes <= last; i += lanes) {
+      for(std::size_t j = 0; j < reduce_lanes; ++j) {
+         acc[j] = op(acc[j], A.un(i + to_index_t(j)));
+      }
+   }
+
+   for(std::size_t j = 0; i < last; ++i, ++j) {
+      acc[j] = op(acc[j], A.un(i));
+   }
+   return reduce_lanes_tree(acc, op);
+}
+
+
+template <typename Base, typename Op>
+STRICT_CONSTEXPR ValueTypeOf<Base> reduce_range(const Base& A, index_t first, index_t last, Op op) {
+   if(last - first < to_index_t(reduce_lanes)) {
+      auto s = A.un(first);
+      for(index_t i = first + 1_sl; i < last; ++i) {
+         s = op(s, A.un(i));
+      }
+      return s;
+   }
+
+   if constexpr(PacketReducible<Base, Op>) {
+      if(!std::is_constant_evaluated()) {
+         return reduce_range_packet(A, first, last, op);
+      }
+   }
+   return reduce_range_scalar(A, first, last, op);
+}
+
+
+// Combines results of blocks [b0, b1), where leaf(b) returns the result of block b.
+template <typename T, typename Leaf, typename Op>
+STRICT_CONSTEXPR T reduce_tree(index_t b0, index_t b1, Leaf leaf, Op op) {
+   if(b1 - b0 == 1_sl) {
+      return leaf(b0);
+   }
+   const index_t mid = b0 + (b1 - b0) / 2_sl;
+   return op(reduce_tree<T>(b0, mid, leaf, op), reduce_tree<T>(mid, b1, leaf, op));
+}
+
+
+// Reduces nonempty A according to the contract above.
+template <BaseType Base, typename Op>
+STRICT_CONSTEXPR ValueTypeOf<Base> reduce(const Base& A, Op op) {
+   using T = ValueTypeOf<Base>;
+   const index_t n = A.size();
+   const index_t block{reduce_block};
+   const index_t nblocks = (n + block - 1_sl) / block;
+
+   auto block_result = [&A, &op, n, block](index_t b) {
+      return reduce_range(A, b * block, mins(b * block + block, n), op);
+   };
+
+   if(!std::is_constant_evaluated() && nblocks > 1_sl && use_parallel_read<Base>(n)) {
+      std::vector<T> partial(to_size_t(nblocks));
+      parallel_for(nblocks, 1_sl, [&](index_t first, index_t last) {
+         for(index_t b = first; b < last; ++b) {
+            partial[to_size_t(b)] = block_result(b);
+         }
+      });
+      return reduce_tree<T>(0_sl, nblocks, [&partial](index_t b) { return partial[to_size_t(b)]; },
+                            op);
+   }
+   return reduce_tree<T>(0_sl, nblocks, block_result, op);
+}
+
+
+}  // namespace spp::detail
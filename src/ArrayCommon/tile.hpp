@@ -0,0 +1,99 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "alignment.hpp"
+#include "array_traits.hpp"
+#include "packet.hpp"
+
+
+namespace spp::detail {
+
+
+// W x W block of a two-dimensional object, one packet per row, where W is the number of
+// elements in a packet. Not constrained for the same reason as Packet.
+template <typename T>
+using Tile = std::array<Packet<T>, sizeof(Packet<T>) / sizeof(T)>;
+
+
+// Two-dimensional objects whose blocks can be read tile by tile: row-major arrays and
+// expressions that provide load_tile(i, j), e.g. transpose.
+template <typename T> concept TileReadable
+    = TwoDimBaseType<T> && PacketBuiltin<BuiltinTypeOf<T>>
+   && (ContiguousBaseType<T> || requires(const T& A, ImplicitInt i) {
+         { A.load_tile(i, i) } -> SameAs<Tile<BuiltinTypeOf<T>>>;
+      });
+
+
+template <typename Base1, typename Base2> concept TileCopyable
+    = TileReadable<Base1> && TwoDimBaseType<Base2>
+   && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>> && !ColContiguousBaseType<Base2>
+   && requires(Base2& A) {
+         { A.data() } -> SameAs<ValueTypeOf<Base2>*>;
+      };
+
+
+// Rows i, ..., i + W - 1 and columns j, ..., j + W - 1 of A.
+template <TileReadable Base>
+STRICT_NODISCARD_INLINE auto load_tile(const Base& A, index_t i, index_t j) {
+   if constexpr(ContiguousBaseType<Base>) {
+      using T = BuiltinTypeOf<Base>;
+      const auto* p = A.data() + (i * A.cols() + j).val();
+      Tile<T> x;
+      for(std::size_t r = 0; r < x.size(); ++r) {
+         x[r] = load_packet<Unaligned>(p + long(r) * A.cols().val());
+      }
+      return x;
+   } else {
+      return A.load_tile(i, j);
+   }
+}
+
+
+// Writes rows of x to p, p + n, ..., p + (W - 1) * n.
+template <PacketBuiltin T>
+STRICT_INLINE void store_tile(Strict<T>* p, index_t n, const Tile<T>& x) {
+   for(std::size_t r = 0; r < x.size(); ++r) {
+      store_packet<Unaligned>(p + long(r) * n.val(), x[r]);
+   }
+}
+
+
+// Swaps K x K blocks above the diagonal of 2K x 2K blocks with the ones below it.
+template <PacketBuiltin T, std::size_t K, std::size_t... I>
+STRICT_INLINE void transpose_stage(Tile<T>& x, std::index_sequence<I...>) {
+   constexpr std::size_t W = sizeof...(I);
+   for(std::size_t r = 0; r < W; ++r) {
+      if((r & K) == 0) {
+         const Packet<T> lo
+             = __builtin_shufflevector(x[r], x[r + K], ((I & K) == 0 ? I : W + I - K)...);
+         const Packet<T> hi
+             = __builtin_shufflevector(x[r], x[r + K], ((I & K) == 0 ? I + K : W + I)...);
+         x[r] = lo;
+         x[r + K] = hi;
+      }
+   }
+}
+
+
+// Transposes x in registers by log2(W) stages of shuffles, each swapping blocks half the size
+// of the previous one.
+template <PacketBuiltin T, std::size_t K = std::size_t(packet_size<T>()) / 2>
+STRICT_INLINE void transpose_tile(Tile<T>& x) {
+   if constexpr(K > 0) {
+      transpose_stage<T, K>(x, std::make_index_sequence<std::size_t(packet_size<T>())>{});
+      transpose_tile<T, K / 2>(x);
+   }
+}
+
+
+}  // namespace spp::detail
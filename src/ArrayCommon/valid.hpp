@@ -144,4 +144,22 @@ STRICT_CONSTEXPR std::vector<ImplicitInt> complement_index_vector(
 }
 
 
+// Calls f(i, k) for every i in [0, n) that is not in indexes, in increasing order, where k is
+// the position of i in the complement. Since k <= i, moving element i to k for every call
+// removes indexes in a single stable pass.
+template <typename F>
+STRICT_CONSTEXPR index_t for_each_complement_index(index_t n,
+                                                   const std::vector<ImplicitInt>& indexes, F f) {
+   index_t k = 0_sl;
+   for(index_t i = 0_sl, cnt = 0_sl; i < n; ++i) {
+      if(bool{to_size_t(cnt) < indexes.size()} && bool{i == indexes[to_size_t(cnt)].get()}) {
+         ++cnt;
+      } else {
+         f(i, k++);
+      }
+   }
+   return k;
+}
+
+
 }  // namespace spp::detail
@@ -422,6 +422,16 @@ template <typename Base1, typename Base2>
 STRICT_CONSTEXPR auto matvec_prod(Base1&& A1, Base2&& A2) = delete;
 
 
+template <OneDimRealBaseType Base1, TwoDimRealBaseType Base2>
+STRICT_CONSTEXPR auto vecmat_prod(const Base1& x, const Base2& A);
+
+
+template <typename Base1, typename Base2>
+   requires OneDimRealBaseType<RemoveRef<Base1>> && TwoDimRealBaseType<RemoveRef<Base2>>
+             && (detail::ArrayRealTypeRvalue<Base1> || detail::ArrayRealTypeRvalue<Base2>)
+STRICT_CONSTEXPR auto vecmat_prod(Base1&& A1, Base2&& A2) = delete;
+
+
 namespace detail {
 
 
@@ -455,267 +465,268 @@ STRICT_CONSTEXPR auto generate(const Base1& A1, const Base2& A2, F f) {
 
 template <RealBaseType Base1, RealBaseType Base2>
 STRICT_CONSTEXPR auto operator+(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryPlus{});
+   return spp::generate(A1, A2, expr::BinaryPlus{});
 }
 
 
 template <RealBaseType Base1, RealBaseType Base2>
 STRICT_CONSTEXPR auto operator-(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryMinus{});
+   return spp::generate(A1, A2, expr::BinaryMinus{});
 }
 
 
 template <RealBaseType Base1, RealBaseType Base2>
 STRICT_CONSTEXPR auto operator*(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryMult{});
+   return spp::generate(A1, A2, expr::BinaryMult{});
 }
 
 
 template <RealBaseType Base1, RealBaseType Base2>
 STRICT_CONSTEXPR auto operator/(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryDivide{});
+   return spp::generate(A1, A2, expr::BinaryDivide{});
 }
 
 
 template <IntegerBaseType Base1, IntegerBaseType Base2>
 STRICT_CONSTEXPR auto operator%(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryModulo{});
+   return spp::generate(A1, A2, expr::BinaryModulo{});
 }
 
 
 template <IntegerBaseType Base1, IntegerBaseType Base2>
 STRICT_CONSTEXPR auto operator<<(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryRightShift{});
+   return spp::generate(A1, A2, expr::BinaryRightShift{});
 }
 
 
 template <IntegerBaseType Base1, IntegerBaseType Base2>
 STRICT_CONSTEXPR auto operator>>(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryLeftShift{});
+   return spp::generate(A1, A2, expr::BinaryLeftShift{});
 }
 
 
 template <IntegerBaseType Base1, IntegerBaseType Base2>
 STRICT_CONSTEXPR auto operator&(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryBitwiseAnd{});
+   return spp::generate(A1, A2, expr::BinaryBitwiseAnd{});
 }
 
 
 template <IntegerBaseType Base1, IntegerBaseType Base2>
 STRICT_CONSTEXPR auto operator|(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryBitwiseOr{});
+   return spp::generate(A1, A2, expr::BinaryBitwiseOr{});
 }
 
 
 template <IntegerBaseType Base1, IntegerBaseType Base2>
 STRICT_CONSTEXPR auto operator^(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryBitwiseXor{});
+   return spp::generate(A1, A2, expr::BinaryBitwiseXor{});
 }
 
 
 template <BooleanBaseType Base1, BooleanBaseType Base2>
 STRICT_CONSTEXPR auto operator&&(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryBooleanAnd{});
+   return spp::generate(A1, A2, expr::BinaryBooleanAnd{});
 }
 
 
 template <BooleanBaseType Base1, BooleanBaseType Base2>
 STRICT_CONSTEXPR auto operator||(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryBooleanOr{});
+   return spp::generate(A1, A2, expr::BinaryBooleanOr{});
 }
 
 
 template <BooleanBaseType Base1, BooleanBaseType Base2>
 STRICT_CONSTEXPR auto operator^(const Base1& A1, const Base2& A2) {
-   return generate(A1, A2, expr::BinaryBooleanXor{});
+   return spp::generate(A1, A2, expr::BinaryBooleanXor{});
 }
 
 
 template <FloatingBaseType Base1, FloatingBaseType Base2>
 auto two_prod(const Base1& A1, const Base2& A2) {
-   return std::pair{generate(A1, A2, expr::BinaryTwoProdFirst{}),
-                    generate(A1, A2, expr::BinaryTwoProdSecond{})};
+   return std::pair{spp::generate(A1, A2, expr::BinaryTwoProdFirst{}),
+                    spp::generate(A1, A2, expr::BinaryTwoProdSecond{})};
 }
 
 
 template <FloatingBaseType Base1, SignedIntegerBaseType Base2>
 auto pow_prod(const Base1& A1, const Base2& A2) {
-   return std::pair{generate(A1, A2, expr::BinaryPowProdFirst{}),
-                    generate(A1, A2, expr::BinaryPowProdSecond{})};
+   return std::pair{spp::generate(A1, A2, expr::BinaryPowProdFirst{}),
+                    spp::generate(A1, A2, expr::BinaryPowProdSecond{})};
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator+(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryPlus{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryPlus{});
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator-(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryMinus{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryMinus{});
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator*(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryMult{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryMult{});
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator/(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryDivide{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryDivide{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator%(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryModulo{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryModulo{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator<<(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryRightShift{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryRightShift{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator>>(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryLeftShift{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryLeftShift{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator&(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryBitwiseAnd{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryBitwiseAnd{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator|(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryBitwiseOr{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryBitwiseOr{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator^(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryBitwiseXor{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryBitwiseXor{});
 }
 
 
 template <BooleanBaseType Base>
 STRICT_CONSTEXPR auto operator&&(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryBooleanAnd{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryBooleanAnd{});
 }
 
 
 template <BooleanBaseType Base>
 STRICT_CONSTEXPR auto operator||(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryBooleanOr{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryBooleanOr{});
 }
 
 
 template <BooleanBaseType Base>
 STRICT_CONSTEXPR auto operator^(ValueTypeOf<Base> x, const Base& A) {
-   return generate(detail::generate_const(A, x), A, expr::BinaryBooleanXor{});
+   return spp::generate(detail::generate_const(A, x), A, expr::BinaryBooleanXor{});
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator+(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryPlus{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryPlus{});
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator-(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryMinus{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryMinus{});
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator*(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryMult{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryMult{});
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR auto operator/(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryDivide{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryDivide{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator%(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryModulo{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryModulo{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator<<(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryRightShift{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryRightShift{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator>>(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryLeftShift{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryLeftShift{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator&(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryBitwiseAnd{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryBitwiseAnd{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator|(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryBitwiseOr{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryBitwiseOr{});
 }
 
 
 template <IntegerBaseType Base>
 STRICT_CONSTEXPR auto operator^(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryBitwiseXor{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryBitwiseXor{});
 }
 
 
 template <BooleanBaseType Base>
 STRICT_CONSTEXPR auto operator&&(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryBooleanAnd{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryBooleanAnd{});
 }
 
 
 template <BooleanBaseType Base>
 STRICT_CONSTEXPR auto operator||(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryBooleanOr{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryBooleanOr{});
 }
 
 
 template <BooleanBaseType Base>
 STRICT_CONSTEXPR auto operator^(const Base& A, ValueTypeOf<Base> x) {
-   return generate(A, detail::generate_const(A, x), expr::BinaryBooleanXor{});
+   return spp::generate(A, detail::generate_const(A, x), expr::BinaryBooleanXor{});
 }
 
 
 template <TwoDimRealBaseType Base1, OneDimRealBaseType Base2>
 STRICT_CONSTEXPR auto matvec_prod(const Base1& A, const Base2& x) {
    ASSERT_STRICT_DEBUG(A.cols() == x.size());
-   // Re-implement dot product function here so that array_ops header does not need
-   // to be included. It is also implemented slightly differently.
-   auto dot = [](const auto& x1, const auto& x2) {
-      ValueTypeOf<Base1> s{};
-      for(index_t i = 0_sl; i < x1.size(); ++i) {
-         s += x1[i] * x2[i];
-      }
-      return s;
-   };
-   return row_reduce(A, [&x, &dot](auto row) { return dot(row, x); });
+   using E = detail::MatVecExpr<Base1, Base2, false>;
+   return StrictArrayBase1D<E>{A, x};
+}
+
+
+// Rows of A are traversed contiguously rather than by strided columns.
+template <OneDimRealBaseType Base1, TwoDimRealBaseType Base2>
+STRICT_CONSTEXPR auto vecmat_prod(const Base1& x, const Base2& A) {
+   ASSERT_STRICT_DEBUG(x.size() == A.rows());
+   using E = detail::MatVecExpr<Base2, Base1, true>;
+   return StrictArrayBase1D<E>{A, x};
 }
 
 
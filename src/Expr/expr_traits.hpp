@@ -7,6 +7,8 @@
 #include <type_traits>
 
 #include "../ArrayCommon/array_traits.hpp"
+#include "../ArrayCommon/packet.hpp"
+#include "../ArrayCommon/tile.hpp"
 #include "../StrictCommon/common_traits.hpp"
 #include "../StrictCommon/strict_traits.hpp"
 
@@ -22,6 +24,43 @@ template <typename T1, typename T2, typename F> concept BinaryOperation
     = StrictType<std::invoke_result_t<F, ValueTypeOf<T1>, ValueTypeOf<T2>>>;
 
 
+// Operations that generate packets without reading their argument, e.g. constants.
+template <typename F> concept GeneratorPacketOperation = requires(const F& f) { f.packet(); };
+
+
+template <typename T, typename F> concept UnaryPacketOperation
+    = GeneratorPacketOperation<F>
+   || (detail::PacketReadable<T>
+       && requires(const F& f, detail::Packet<BuiltinTypeOf<T>> x) {
+             { f.packet(x) } -> SameAs<detail::Packet<BuiltinTypeOf<T>>>;
+          });
+
+
+template <typename T1, typename T2, typename F> concept BinaryPacketOperation
+    = detail::PacketReadable<T1> && detail::PacketReadable<T2>
+   && SameAs<BuiltinTypeOf<T1>, BuiltinTypeOf<T2>>
+   && requires(const F& f, detail::Packet<BuiltinTypeOf<T1>> x) {
+         { f.packet(x, x) } -> SameAs<detail::Packet<BuiltinTypeOf<T1>>>;
+      };
+
+
+// Two-dimensional operations that can be evaluated tile by tile.
+template <typename T, typename F> concept UnaryTileOperation
+    = GeneratorPacketOperation<F>
+   || (detail::TileReadable<T>
+       && requires(const F& f, detail::Packet<BuiltinTypeOf<T>> x) {
+             { f.packet(x) } -> SameAs<detail::Packet<BuiltinTypeOf<T>>>;
+          });
+
+
+template <typename T1, typename T2, typename F> concept BinaryTileOperation
+    = detail::TileReadable<T1> && detail::TileReadable<T2>
+   && SameAs<BuiltinTypeOf<T1>, BuiltinTypeOf<T2>>
+   && requires(const F& f, detail::Packet<BuiltinTypeOf<T1>> x) {
+         { f.packet(x, x) } -> SameAs<detail::Packet<BuiltinTypeOf<T1>>>;
+      };
+
+
 }  // namespace spp::expr
 
 
@@ -4,6 +4,7 @@
 #pragma once
 
 
+#include "../ArrayCommon/packet.hpp"
 #include "../StrictCommon/strict_common.hpp"
 
 
@@ -16,6 +17,11 @@ struct UnaryPlus {
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x) const {
       return +x;
    }
+
+   // Packet evaluation, see ArrayCommon/packet.hpp.
+   STRICT_NODISCARD_INLINE auto packet(auto x) const {
+      return x;
+   }
 };
 
 
@@ -27,6 +33,10 @@ struct UnaryMinus {
       }
       return -x;
    }
+
+   STRICT_NODISCARD_INLINE auto packet(auto x) const {
+      return -x;
+   }
 };
 
 
@@ -51,6 +61,10 @@ struct UnaryAbs {
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x) const {
       return abss(x);
    }
+
+   STRICT_NODISCARD_INLINE auto packet(auto x) const {
+      return x > 0 ? x : -x;
+   }
 };
 
 
@@ -172,12 +186,38 @@ struct UnaryCast {
 };
 
 
+template <Builtin T>
+struct UnaryConst {
+   STRICT_CONSTEXPR explicit UnaryConst(Strict<T> c) : c_{c} {
+   }
+
+   template <Builtin U>
+   STRICT_CONSTEXPR Strict<T> operator()([[maybe_unused]] Strict<U> x) const {
+      return c_;
+   }
+
+   // Packet evaluation, see ArrayCommon/packet.hpp. The argument is not read.
+   STRICT_NODISCARD_INLINE auto packet() const
+      requires detail::PacketBuiltin<T>
+   {
+      return detail::broadcast_packet(c_);
+   }
+
+private:
+   Strict<T> c_;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 struct BinaryPlus {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x + y;
    }
+
+   STRICT_NODISCARD_INLINE auto packet(auto x, auto y) const {
+      return x + y;
+   }
 };
 
 
@@ -186,6 +226,10 @@ struct BinaryMinus {
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x - y;
    }
+
+   STRICT_NODISCARD_INLINE auto packet(auto x, auto y) const {
+      return x - y;
+   }
 };
 
 
@@ -194,6 +238,10 @@ struct BinaryMult {
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x * y;
    }
+
+   STRICT_NODISCARD_INLINE auto packet(auto x, auto y) const {
+      return x * y;
+   }
 };
 
 
@@ -202,6 +250,10 @@ struct BinaryDivide {
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x / y;
    }
+
+   STRICT_NODISCARD_INLINE auto packet(auto x, auto y) const {
+      return x / y;
+   }
 };
 
 
@@ -475,9 +475,8 @@ STRICT_CONSTEXPR auto identity(ImplicitInt n) {
 
 template <TwoDimBaseType Base>
 STRICT_CONSTEXPR auto transpose(const Base& A) {
-   auto op = [&A](index_t i, index_t j) { return A.un(j, i); };
-   using E = detail::IndexExpr2D<BuiltinTypeOf<Base>, decltype(op)>;
-   return StrictArrayBase2D<E>{A.cols(), A.rows(), op};
+   using E = detail::TransposeExpr<Base>;
+   return StrictArrayBase2D<E>{A};
 }
 
 
@@ -485,7 +484,7 @@ STRICT_CONSTEXPR auto transpose(const Base& A) {
 template <Builtin T>
 STRICT_CONSTEXPR auto const1D(ImplicitInt size, Strict<T> c) {
    ASSERT_STRICT_DEBUG(size.get() > -1_sl);
-   return generate(irange(size), [c]([[maybe_unused]] auto i) { return c; });
+   return generate(irange(size), expr::UnaryConst<T>{c});
 }
 
 
@@ -500,7 +499,7 @@ STRICT_CONSTEXPR auto const2D(ImplicitInt rows, ImplicitInt cols, Strict<T> c) {
    ASSERT_STRICT_DEBUG(rows.get() > -1_sl);
    ASSERT_STRICT_DEBUG(cols.get() > -1_sl);
    ASSERT_STRICT_DEBUG(detail::semi_valid_row_col_sizes(rows.get(), cols.get()));
-   return generate(detail::irange2D(rows, cols), [c]([[maybe_unused]] auto i) { return c; });
+   return generate(detail::irange2D(rows, cols), expr::UnaryConst<T>{c});
 }
 
 
@@ -4,10 +4,15 @@
 #pragma once
 
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <utility>
 
 #include "../ArrayCommon/array_auxiliary.hpp"
 #include "../ArrayCommon/array_traits.hpp"
+#include "../ArrayCommon/packet.hpp"
+#include "../ArrayCommon/tile.hpp"
 #include "../ArrayCommon/valid.hpp"
 #include "../StrictCommon/strict_common.hpp"
 #include "expr_traits.hpp"
@@ -53,6 +58,16 @@ public:
       return op_(A_.un(i));
    }
 
+   STRICT_NODISCARD_INLINE Packet<builtin_type> load_packet(ImplicitInt i) const
+      requires expr::UnaryPacketOperation<Base, Op>
+   {
+      if constexpr(expr::GeneratorPacketOperation<Op>) {
+         return op_.packet();
+      } else {
+         return op_.packet(A_.load_packet(i));
+      }
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
       return A_.size();
    }
@@ -92,6 +107,22 @@ public:
       return ExprBase::op_(ExprBase::A_.un(i, j));
    }
 
+   STRICT_NODISCARD_INLINE Tile<typename ExprBase::builtin_type> load_tile(ImplicitInt i,
+                                                                          ImplicitInt j) const
+      requires expr::UnaryTileOperation<Base, Op>
+   {
+      Tile<typename ExprBase::builtin_type> x;
+      if constexpr(expr::GeneratorPacketOperation<Op>) {
+         x.fill(ExprBase::op_.packet());
+      } else {
+         x = detail::load_tile(ExprBase::A_, i.get(), j.get());
+         for(auto& row : x) {
+            row = ExprBase::op_.packet(row);
+         }
+      }
+      return x;
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t rows() const {
       return ExprBase::A_.rows();
    }
@@ -135,6 +166,12 @@ public:
       return op_(A1_.un(i), A2_.un(i));
    }
 
+   STRICT_NODISCARD_INLINE Packet<builtin_type> load_packet(ImplicitInt i) const
+      requires expr::BinaryPacketOperation<Base1, Base2, Op>
+   {
+      return op_.packet(A1_.load_packet(i), A2_.load_packet(i));
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
       return A1_.size();
    }
@@ -175,6 +212,18 @@ public:
       return ExprBase::op_(ExprBase::A1_.un(i, j), ExprBase::A2_.un(i, j));
    }
 
+   STRICT_NODISCARD_INLINE Tile<typename ExprBase::builtin_type> load_tile(ImplicitInt i,
+                                                                          ImplicitInt j) const
+      requires expr::BinaryTileOperation<Base1, Base2, Op>
+   {
+      auto x = detail::load_tile(ExprBase::A1_, i.get(), j.get());
+      const auto y = detail::load_tile(ExprBase::A2_, i.get(), j.get());
+      for(std::size_t r = 0; r < x.size(); ++r) {
+         x[r] = ExprBase::op_.packet(x[r], y[r]);
+      }
+      return x;
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t rows() const {
       return ExprBase::A1_.rows();
    }
@@ -267,6 +316,56 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Assignment evaluates transposes tile by tile if A can be read in tiles, see copy.
+template <TwoDimBaseType Base>
+class STRICT_NODISCARD TransposeExpr : private CopyBase2D {
+public:
+   using value_type = ValueTypeOf<Base>;
+   using builtin_type = BuiltinTypeOf<Base>;
+
+   STRICT_NODISCARD_CONSTEXPR explicit TransposeExpr(const Base& A) : A_{A} {
+   }
+
+   STRICT_NODISCARD_CONSTEXPR TransposeExpr(const TransposeExpr&) = default;
+   STRICT_CONSTEXPR TransposeExpr& operator=(const TransposeExpr&) = delete;
+   STRICT_CONSTEXPR ~TransposeExpr() = default;
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE value_type un(ImplicitInt i) const {
+      auto [r, c] = index_map_one_to_two_dim(*this, i);
+      return this->un(r, c);
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE value_type un(ImplicitInt i, ImplicitInt j) const {
+      return A_.un(j, i);
+   }
+
+   STRICT_NODISCARD_INLINE Tile<builtin_type> load_tile(ImplicitInt i, ImplicitInt j) const
+      requires TileReadable<Base>
+   {
+      auto x = detail::load_tile(A_, j.get(), i.get());
+      transpose_tile<builtin_type>(x);
+      return x;
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
+      return A_.size();
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t rows() const {
+      return A_.cols();
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t cols() const {
+      return A_.rows();
+   }
+
+private:
+   // Slice arrays are stored by copy, arrays by reference.
+   typename CopyOrReferenceExpr<AddConst<Base>>::type A_;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <TwoDimBaseType Base, typename Op, bool rowwise>
 class STRICT_NODISCARD ReduceExpr : private CopyBase1D {
@@ -308,9 +407,146 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Number of rows of A that eval_range of x^T * A reads at once.
+inline constexpr index_t matvec_block_rows{8L};
+
+
+// Products A * x if transposed is false and x^T * A otherwise. Each element is accumulated
+// from left to right starting from zero, both by un and by load_packet, which computes
+// packet_size elements at once from tiles of A.
+template <TwoDimBaseType Base1, OneDimBaseType Base2, bool transposed>
+class STRICT_NODISCARD MatVecExpr : private CopyBase1D {
+public:
+   using value_type = ValueTypeOf<Base1>;
+   using builtin_type = BuiltinTypeOf<Base1>;
+
+   STRICT_NODISCARD_CONSTEXPR explicit MatVecExpr(const Base1& A, const Base2& x)
+       : A_{A},
+         x_{x} {
+   }
+
+   STRICT_NODISCARD_CONSTEXPR MatVecExpr(const MatVecExpr&) = default;
+   STRICT_CONSTEXPR MatVecExpr& operator=(const MatVecExpr&) = delete;
+   STRICT_CONSTEXPR ~MatVecExpr() = default;
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE value_type un(ImplicitInt i) const {
+      value_type s{};
+      if constexpr(transposed) {
+         for(index_t k = 0_sl; k < A_.rows(); ++k) {
+            s += x_.un(k) * A_.un(k, i);
+         }
+      } else {
+         for(index_t j = 0_sl; j < A_.cols(); ++j) {
+            s += A_.un(i, j) * x_.un(j);
+         }
+      }
+      return s;
+   }
+
+   // Tiles are transposed for A * x so that each packet holds one column of the tile.
+   STRICT_NODISCARD_INLINE Packet<builtin_type> load_packet(ImplicitInt i) const
+      requires TileReadable<Base1>
+   {
+      constexpr index_t W{packet_size<builtin_type>()};
+      Packet<builtin_type> s{};
+      if constexpr(transposed) {
+         index_t k = 0_sl;
+         for(; k + W <= A_.rows(); k += W) {
+            const auto t = detail::load_tile(A_, k, i.get());
+            for(std::size_t r = 0; r < t.size(); ++r) {
+               s += broadcast_packet(x_.un(k.val() + long(r))) * t[r];
+            }
+         }
+         for(; k < A_.rows(); ++k) {
+            s += broadcast_packet(x_.un(k)) * load_lanes(k, i.get(), 0_sl, 1_sl);
+         }
+      } else {
+         index_t j = 0_sl;
+         for(; j + W <= A_.cols(); j += W) {
+            auto t = detail::load_tile(A_, i.get(), j);
+            transpose_tile<builtin_type>(t);
+            for(std::size_t c = 0; c < t.size(); ++c) {
+               s += t[c] * broadcast_packet(x_.un(j.val() + long(c)));
+            }
+         }
+         for(; j < A_.cols(); ++j) {
+            s += load_lanes(i.get(), j, 1_sl, 0_sl) * broadcast_packet(x_.un(j));
+         }
+      }
+      return s;
+   }
+
+   // Writes elements [first, last) of x^T * A to p. Blocks of matvec_block_rows rows of A
+   // are read contiguously, and the partial sums in p are updated in the same order as by un.
+   STRICT_INLINE void eval_range(value_type* p, index_t first, index_t last) const
+      requires transposed && ContiguousBaseType<Base1> && PacketBuiltin<builtin_type>
+   {
+      constexpr index_t W{packet_size<builtin_type>()};
+      constexpr std::size_t R = std::size_t(matvec_block_rows.val());
+      const index_t m = A_.rows();
+      const index_t n = A_.cols();
+      const index_t mb = m / matvec_block_rows * matvec_block_rows;
+      p -= first.val();
+
+      std::fill(p + first.val(), p + last.val(), value_type{});
+      for(index_t k0 = 0_sl; k0 < mb; k0 += matvec_block_rows) {
+         std::array<const value_type*, R> row;
+         Packet<builtin_type> xk[R];
+         for(std::size_t r = 0; r < R; ++r) {
+            row[r] = A_.data() + (k0.val() + long(r)) * n.val();
+            xk[r] = broadcast_packet(x_.un(k0.val() + long(r)));
+         }
+         index_t j = first;
+         for(; j + W <= last; j += W) {
+            auto s = detail::load_packet<Unaligned>(p + j.val());
+            for(std::size_t r = 0; r < R; ++r) {
+               s += xk[r] * detail::load_packet<Unaligned>(row[r] + j.val());
+            }
+            detail::store_packet<Unaligned>(p + j.val(), s);
+         }
+         for(; j < last; ++j) {
+            for(std::size_t r = 0; r < R; ++r) {
+               p[j.val()] += x_.un(k0.val() + long(r)) * row[r][j.val()];
+            }
+         }
+      }
+      for(index_t k = mb; k < m; ++k) {
+         for(index_t j = first; j < last; ++j) {
+            p[j.val()] += x_.un(k) * A_.un(k, j);
+         }
+      }
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
+      if constexpr(transposed) {
+         return A_.cols();
+      } else {
+         return A_.rows();
+      }
+   }
+
+private:
+   // Slice arrays are stored by copy, arrays by reference.
+   typename CopyOrReferenceExpr<AddConst<Base1>>::type A_;
+   typename CopyOrReferenceExpr<AddConst<Base2>>::type x_;
+
+   // Elements A(i + l * di, j + l * dj) for lanes l of the remaining rows or columns,
+   // which do not fill a tile.
+   STRICT_NODISCARD_INLINE Packet<builtin_type> load_lanes(index_t i, index_t j, index_t di,
+                                                           index_t dj) const {
+      Packet<builtin_type> p;
+      for(index_t l = 0_sl; l < index_t{packet_size<builtin_type>()}; ++l) {
+         p[l.val()] = A_.un(i + l * di, j + l * dj).val();
+      }
+      return p;
+   }
+};
+
+
 template <BaseType Base, typename Op>
    requires expr::UnaryOperation<Base, Op>
-class STRICT_NODISCARD RandUnaryExpr : public UnaryExpr<Base, Op, true> {
+class STRICT_NODISCARD RandUnaryExpr : public UnaryExpr<Base, Op, true>, private SequentialBase {
 public:
    using typename UnaryExpr<Base, Op, true>::value_type;
    using typename UnaryExpr<Base, Op, true>::builtin_type;
@@ -176,6 +176,10 @@ class STRICT_NODISCARD Odd{};
 
 class STRICT_NODISCARD Reverse{};
 
+class STRICT_NODISCARD Uninitialized{};
+
+class STRICT_NODISCARD FirstTouch{};
+
 }  // namespace detail
 
 
@@ -206,6 +210,14 @@ constexpr inline Last last{0};
 using place::last;
 
 
+// Construction tags for arrays. Elements of uninitialized arrays have indeterminate values
+// and must be written before they are read. first_touch zeroes elements in parallel, in the
+// chunks in which parallel operations later process them, so that memory pages are placed
+// on the NUMA node of the thread that uses them.
+constexpr inline detail::Uninitialized uninitialized;
+constexpr inline detail::FirstTouch first_touch;
+
+
 // Note that plus operator is allowed from both sides bot not minus.
 STRICT_NODISCARD_CONSTEXPR_INLINE Last operator+(Last lst, ImplicitInt i) {
    return Last{ImplicitInt{lst.get() - i.get()}};
@@ -63,6 +63,33 @@
 #endif
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Packets are built on GCC vector extensions, which are also supported by clang and
+// Intel compilers. They are lowered to AVX-512, AVX2 or SSE instructions depending on
+// the target. Define STRICT_SIMD_OFF to always evaluate element by element.
+#if !defined STRICT_SIMD_OFF \
+    && (defined __GNUG__ || defined __clang__ || defined __INTEL_LLVM_COMPILER)
+#define STRICT_SIMD_PACKETS
+
+#if defined __AVX512F__
+#define STRICT_SIMD_BYTES 64
+#elif defined __AVX__
+#define STRICT_SIMD_BYTES 32
+#else
+#define STRICT_SIMD_BYTES 16
+#endif
+
+#endif
+
+
+// Arrays with the Aligned flag are aligned to STRICT_ALIGNMENT bytes, a cache line by
+// default. It can be set to any power of two, e.g. 32 for AVX2 or 64 for AVX-512, and is
+// raised to the packet size if smaller, so that aligned packet loads remain valid.
+#ifndef STRICT_ALIGNMENT
+#define STRICT_ALIGNMENT 64
+#endif
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifdef STRICT_QUAD_PRECISION
 
@@ -151,6 +178,20 @@ inline void config_info() {
 #else
    std::cout << "C++23 stacktrace: ON" << '\n';
 #endif
+
+#ifndef STRICT_PARALLEL
+   std::cout << "multithreading: OFF" << '\n';
+#else
+   std::cout << "multithreading: ON" << '\n';
+#endif
+
+#ifndef STRICT_SIMD_PACKETS
+   std::cout << "SIMD packets: OFF" << '\n';
+#else
+   std::cout << "SIMD packets: " << STRICT_SIMD_BYTES << " bytes" << '\n';
+#endif
+
+   std::cout << "alignment: " << STRICT_ALIGNMENT << " bytes" << '\n';
 }
 
 
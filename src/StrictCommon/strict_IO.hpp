@@ -7,12 +7,18 @@
 #ifdef STRICT_QUAD_PRECISION
 #include <cstddef>  // ptrdiff_t
 #endif
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 
 #include "auxiliary_types.hpp"
 #include "common_traits.hpp"
@@ -83,6 +89,7 @@ class StrictFormat {
 public:
    StrictFormat& reset() {
       scientific_ = true_sb;
+      shortest_ = false_sb;
       precision_[0] = float_precision;
       precision_[1] = double_precision;
       precision_[2] = long_double_precision;
@@ -99,6 +106,17 @@ public:
       return *this;
    }
 
+   StrictBool is_shortest() const {
+      return shortest_;
+   }
+
+   // Floating-point numbers are printed with the fewest digits that are read back as the same
+   // number, scientific and precision settings are ignored.
+   StrictFormat& shortest(ImplicitBool b) {
+      shortest_ = b.get();
+      return *this;
+   }
+
    template <Floating PT>
    StrictInt precision() const {
       if constexpr(SameAs<PT, float>) {
@@ -146,11 +164,6 @@ public:
    template <StandardFloating T>
    friend std::ostream& spp::operator<<(std::ostream& os, Strict<T> x);
 
-#ifdef STRICT_QUAD_PRECISION
-   template <Quadruple T>
-   friend std::ostream& spp::operator<<(std::ostream& os, T x);
-#endif
-
 private:
    static constexpr int float_precision = std::numeric_limits<float>::digits10 + 1;
    static constexpr int double_precision = std::numeric_limits<double>::digits10 + 1;
@@ -158,6 +171,7 @@ private:
    static constexpr int quad_precision = 33;
 
    StrictBool scientific_{true};
+   StrictBool shortest_{false};
    int precision_[4]{float_precision, double_precision, long_double_precision, quad_precision};
 
    // Originally a templated lambda inside << operator, but changed to private member
@@ -179,6 +193,104 @@ private:
 inline detail::StrictFormat format;
 
 
+namespace detail {
+
+
+STRICT_INLINE std::to_chars_result copy_chars(char* first, char* last, std::string_view s) {
+   if(last - first < static_cast<std::ptrdiff_t>(s.size())) {
+      return {last, std::errc::value_too_large};
+   }
+   return {std::copy(s.begin(), s.end(), first), std::errc{}};
+}
+
+
+// Formats x into [first, last) as operator<< does, but without streams. Returns
+// std::errc::value_too_large if the characters do not fit.
+template <Boolean T>
+std::to_chars_result format_chars(char* first, char* last, T x) {
+   return copy_chars(first, last, x ? "true" : "false");
+}
+
+
+template <Integer T>
+std::to_chars_result format_chars(char* first, char* last, T x) {
+   if constexpr(SignedInteger<T>) {
+      if(x >= 0) {
+         if(first == last) {
+            return {last, std::errc::value_too_large};
+         }
+         *first++ = '+';
+      }
+   }
+   return std::to_chars(first, last, x);
+}
+
+
+template <StandardFloating T>
+std::to_chars_result format_chars(char* first, char* last, T x) {
+   if(!std::signbit(x)) {
+      if(first == last) {
+         return {last, std::errc::value_too_large};
+      }
+      *first++ = '+';
+   }
+   if(format.is_shortest()) {
+      return std::to_chars(first, last, x);
+   }
+
+   const int precision = format.precision<T>().val();
+   auto r = std::to_chars(first, last, x,
+                          format.is_scientific() ? std::chars_format::scientific
+                                                 : std::chars_format::fixed,
+                          precision);
+   // Decimal point is always printed, as with std::showpoint.
+   if(r.ec == std::errc{} && precision == 0 && std::isfinite(x)) {
+      if(r.ptr == last) {
+         return {last, std::errc::value_too_large};
+      }
+      char* point = std::find(first, r.ptr, 'e');
+      std::copy_backward(point, r.ptr, r.ptr + 1);
+      *point = '.';
+      ++r.ptr;
+   }
+   return r;
+}
+
+
+#ifdef STRICT_QUAD_PRECISION
+// Writes the quadmath_snprintf format to frmt and returns the field width. In shortest mode
+// 36 significant digits are printed, which are enough to read back the same number.
+inline int quad_format(char* frmt, std::size_t size) {
+   if(format.is_shortest()) {
+      std::snprintf(frmt, size, "%%+-#*.%dQE", 35);
+      return 0;
+   }
+   const int precision = format.precision<float128>().val();
+   if(format.is_scientific()) {
+      std::snprintf(frmt, size, "%%+-#*.%dQE", precision);
+      return precision + 7;
+   }
+   std::snprintf(frmt, size, "%%+-#*.%dQF", precision);
+   return precision + 3;
+}
+
+
+template <Quadruple T>
+std::to_chars_result format_chars(char* first, char* last, T x) {
+   char frmt[32];
+   const int width = quad_format(frmt, sizeof(frmt));
+   const int n = quadmath_snprintf(first, std::size_t(last - first), frmt, width, x);
+   if(n < 0 || n >= last - first) {
+      return {last, std::errc::value_too_large};
+   }
+   return {first + n, std::errc{}};
+}
+#endif
+
+
+}  // namespace detail
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <NotQuadruple T>
 std::istream& operator>>(std::istream& is, Strict<T>& x) {
@@ -208,6 +320,11 @@ std::ostream& operator<<(std::ostream& os, Strict<T> x) {
 
 template <StandardFloating T>
 std::ostream& operator<<(std::ostream& os, Strict<T> x) {
+   if(format.shortest_) {
+      char buf[64];
+      const auto r = detail::format_chars(buf, buf + sizeof(buf), T{x});
+      return os << std::string_view(buf, std::size_t(r.ptr - buf));
+   }
    os << std::showpos;
    if(format.scientific_) {
       os << std::scientific << std::showpoint << format.set_float_precision<T>() << T{x};
@@ -246,15 +363,9 @@ std::istream& operator>>(std::istream& is, Strict<T>& x) {
 template <Quadruple T>
 std::ostream& operator<<(std::ostream& os, T x) {
    char buf[128];  // Not declared static since it is not thread safe.
-   if(format.scientific_) {
-      std::string frmt = "%+-#*." + std::to_string(format.precision_[3]) + std::string("QE");
-      int width = format.precision_[3] + 7;
-      quadmath_snprintf(buf, sizeof(buf), frmt.c_str(), width, x);
-   } else {
-      std::string frmt = "%+-#*." + std::to_string(format.precision_[3]) + std::string("QF");
-      int width = format.precision_[3] + 3;
-      quadmath_snprintf(buf, sizeof(buf), frmt.c_str(), width, x);
-   }
+   char frmt[32];
+   const int width = detail::quad_format(frmt, sizeof(frmt));
+   quadmath_snprintf(buf, sizeof(buf), frmt, width, x);
    os << buf;
    return os;
 }
@@ -0,0 +1,301 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "binary_IO.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+#include "mapped_file.hpp"
+
+
+namespace spp {
+
+
+// Archives store named arrays in a single file. Elements of each array are stored as in
+// binary files, see save_binary, starting at a multiple of 64 bytes. They are followed by
+// the table of contents, which gives the name, type, dimensions, and offset of every
+// array, and by a copy of the archive header, which locates the table of contents. The
+// archive is thus written in one pass, and arrays are loaded without reading the others.
+struct ArchiveHeader {
+   static constexpr std::size_t size = 64;
+   static constexpr std::uint8_t current_version = 1;
+
+   char magic[6];
+   std::uint8_t version;
+   std::uint8_t little_endian;
+   std::uint64_t toc_offset;
+   std::uint64_t count;
+   char reserved[40];
+};
+
+
+static_assert(sizeof(ArchiveHeader) == ArchiveHeader::size);
+
+
+namespace detail {
+
+
+inline constexpr char archive_magic[6] = {'S', 'P', 'P', 'A', 'R', 'C'};
+
+
+inline constexpr std::size_t archive_alignment = 64;
+
+
+inline void byteswap_archive_header(ArchiveHeader& h) {
+   byteswap_bytes(&h.toc_offset, sizeof(h.toc_offset), 1);
+   byteswap_bytes(&h.count, sizeof(h.count), 1);
+}
+
+
+// Entries of the table of contents are the length of the name, the name, and the header
+// the array would have in a binary file, with data_offset relative to the beginning of the
+// archive.
+struct ArchiveEntry {
+   std::string name;
+   BinaryHeader header;
+};
+
+
+}  // namespace detail
+
+
+class STRICT_NODISCARD ArchiveWriter {
+public:
+   explicit ArchiveWriter(const std::string& file_path)
+       : file_{detail::open_binary(file_path, "wb")} {
+      const ArchiveHeader h = this->header();
+      detail::write_bytes(file_.get(), &h, sizeof(h));
+      offset_ = sizeof(h);
+   }
+
+   ArchiveWriter(const ArchiveWriter&) = delete;
+   ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+   // Archives that are not closed explicitly are closed here, but errors cannot be reported.
+   ~ArchiveWriter() {
+      if(file_ != nullptr) {
+         try {
+            this->close();
+         } catch(...) {
+         }
+      }
+   }
+
+   // Names must be unique within the archive.
+   void add(const std::string& name, BaseType auto const& A) {
+      using Base = RemoveCVRef<decltype(A)>;
+      using T = BuiltinTypeOf<Base>;
+      ASSERT_STRICT_ALWAYS_MSG(file_ != nullptr, "Archive is closed.\n");
+      ASSERT_STRICT_ALWAYS_MSG(std::none_of(entries_.begin(), entries_.end(),
+                                            [&name](const auto& e) { return e.name == name; }),
+                               "Duplicate array name.\n");
+      BinaryHeader h;
+      if constexpr(OneDimBaseType<Base>) {
+         h = detail::make_binary_header<T>(A.size(), 1_sl, 1L, RowMajor);
+      } else {
+         const Layout L = detail::ColContiguousBaseType<Base> ? ColMajor : RowMajor;
+         h = detail::make_binary_header<T>(A.rows(), A.cols(), 2L, L);
+      }
+
+      this->pad();
+      h.alignment = std::uint32_t(detail::archive_alignment);
+      h.data_offset = offset_;
+      detail::write_binary_elements(file_.get(), A, h.layout == ColMajor && h.rank == 2);
+      offset_ += std::size_t(A.size().val()) * sizeof(T);
+      entries_.push_back({name, h});
+   }
+
+   // Writes the table of contents. No arrays can be added afterwards.
+   void close() {
+      ASSERT_STRICT_ALWAYS_MSG(file_ != nullptr, "Archive is closed.\n");
+      ArchiveHeader h = this->header();
+      h.toc_offset = offset_;
+      h.count = entries_.size();
+      for(const auto& e : entries_) {
+         const auto name_size = std::uint32_t(e.name.size());
+         detail::write_bytes(file_.get(), &name_size, sizeof(name_size));
+         detail::write_bytes(file_.get(), e.name.data(), e.name.size());
+         detail::write_bytes(file_.get(), &e.header, sizeof(e.header));
+      }
+      detail::write_bytes(file_.get(), &h, sizeof(h));
+      ASSERT_STRICT_ALWAYS_MSG(std::fclose(file_.release()) == 0, "Cannot write to the file.\n");
+   }
+
+private:
+   detail::FilePtr file_;
+   std::size_t offset_{};
+   std::vector<detail::ArchiveEntry> entries_;
+
+   static ArchiveHeader header() {
+      ArchiveHeader h{};
+      std::memcpy(h.magic, detail::archive_magic, sizeof(h.magic));
+      h.version = ArchiveHeader::current_version;
+      h.little_endian = detail::native_little_endian;
+      return h;
+   }
+
+   void pad() {
+      static constexpr char zeros[detail::archive_alignment] = {};
+      const std::size_t padding = (detail::archive_alignment - offset_ % detail::archive_alignment)
+                                % detail::archive_alignment;
+      detail::write_bytes(file_.get(), zeros, padding);
+      offset_ += padding;
+   }
+};
+
+
+// Only the table of contents is read when the archive is opened. Each array is read from
+// the file when it is loaded, or, where supported, attached to the mapping of the file.
+class STRICT_NODISCARD ArchiveReader {
+public:
+   explicit ArchiveReader(const std::string& file_path) : file_path_{file_path} {
+      auto f = detail::open_binary(file_path_, "rb");
+      ArchiveHeader h;
+      detail::read_bytes(f.get(), &h, sizeof(h));
+      ASSERT_STRICT_ALWAYS_MSG(std::memcmp(h.magic, detail::archive_magic, sizeof(h.magic)) == 0,
+                               "Invalid archive.\n");
+      ASSERT_STRICT_ALWAYS_MSG(h.version == ArchiveHeader::current_version,
+                               "Unsupported archive version.\n");
+
+      ASSERT_STRICT_ALWAYS(std::fseek(f.get(), -long(sizeof(h)), SEEK_END) == 0);
+      detail::read_bytes(f.get(), &h, sizeof(h));
+      const bool swap = bool(h.little_endian) != detail::native_little_endian;
+      if(swap) {
+         detail::byteswap_archive_header(h);
+      }
+      // Archives that were not closed do not end with the header.
+      ASSERT_STRICT_ALWAYS_MSG(std::memcmp(h.magic, detail::archive_magic, sizeof(h.magic)) == 0
+                                   && h.toc_offset >= sizeof(h),
+                               "Archive is incomplete.\n");
+
+      // Sizes read from the file are checked before anything is allocated for them.
+      ASSERT_STRICT_ALWAYS(std::fseek(f.get(), long(h.toc_offset), SEEK_SET) == 0);
+      constexpr std::size_t min_entry_size = sizeof(std::uint32_t) + sizeof(BinaryHeader);
+      ASSERT_STRICT_ALWAYS_MSG(h.count <= detail::remaining_bytes(f.get()) / min_entry_size,
+                               "Unexpected end of the file.\n");
+      entries_.resize(h.count);
+      for(auto& e : entries_) {
+         std::uint32_t name_size;
+         detail::read_bytes(f.get(), &name_size, sizeof(name_size));
+         if(swap) {
+            detail::byteswap_bytes(&name_size, sizeof(name_size), 1);
+         }
+         ASSERT_STRICT_ALWAYS_MSG(name_size <= detail::remaining_bytes(f.get()),
+                                  "Unexpected end of the file.\n");
+         e.name.resize(name_size);
+         detail::read_bytes(f.get(), e.name.data(), e.name.size());
+         detail::read_bytes(f.get(), &e.header, sizeof(e.header));
+         if(swap) {
+            detail::byteswap_header(e.header);
+         }
+      }
+   }
+
+   std::vector<std::string> names() const {
+      std::vector<std::string> names;
+      for(const auto& e : entries_) {
+         names.push_back(e.name);
+      }
+      return names;
+   }
+
+   bool contains(const std::string& name) const {
+      return this->find(name) != nullptr;
+   }
+
+   template <Builtin T, AlignmentFlag AF>
+   void load(const std::string& name, Array1D<T, AF>& A) const {
+      const BinaryHeader& h = this->entry<T>(name, 1L);
+      auto f = this->open_entry<T>(h);
+      Array1D<T, AF> tmp(h.dims[0], uninitialized);
+      detail::read_binary_elements(f.get(), tmp, h);
+      A.swap(tmp);
+   }
+
+   template <Builtin T, AlignmentFlag AF, Layout L>
+   void load(const std::string& name, Array2D<T, AF, L>& A) const {
+      const BinaryHeader& h = this->entry<T>(name, 2L);
+      auto f = this->open_entry<T>(h);
+      Array2D<T, AF, L> tmp(h.dims[0], h.dims[1], uninitialized);
+      detail::read_binary_elements(f.get(), tmp, h);
+      A.swap(tmp);
+   }
+
+#ifdef __linux__
+   // The file is mapped when the first array is attached. Arrays must be stored in the
+   // byte order of the machine, and two-dimensional ones in the order given by L.
+   template <detail::CompatibleBuiltin T>
+   auto attach1D(const std::string& name) {
+      const BinaryHeader& h = this->mapped_entry<T>(name, 1L);
+      return spp::attach1D<T>(std::as_const(*mapping_), h.dims[0], h.data_offset);
+   }
+
+   template <detail::CompatibleBuiltin T, Layout L = RowMajor>
+   auto attach2D(const std::string& name) {
+      const BinaryHeader& h = this->mapped_entry<T>(name, 2L);
+      ASSERT_STRICT_ALWAYS_MSG(h.layout == L, "Layout of the array does not match.\n");
+      return spp::attach2D<T, L>(std::as_const(*mapping_), h.dims[0], h.dims[1],
+                                 h.data_offset);
+   }
+#endif
+
+private:
+   std::string file_path_;
+   std::vector<detail::ArchiveEntry> entries_;
+#ifdef __linux__
+   std::optional<MappedFile> mapping_;
+#endif
+
+   const BinaryHeader* find(const std::string& name) const {
+      auto it = std::find_if(entries_.begin(), entries_.end(),
+                             [&name](const auto& e) { return e.name == name; });
+      return it != entries_.end() ? &it->header : nullptr;
+   }
+
+   template <Builtin T>
+   const BinaryHeader& entry(const std::string& name, long int rank) const {
+      const BinaryHeader* h = this->find(name);
+      ASSERT_STRICT_ALWAYS_MSG(h != nullptr, "Array is not in the archive.\n");
+      detail::validate_binary_header<T>(*h, rank);
+      return *h;
+   }
+
+   // The file is opened for every array, so that arrays can be loaded concurrently.
+   template <Builtin T>
+   detail::FilePtr open_entry(const BinaryHeader& h) const {
+      auto f = detail::open_binary(file_path_, "rb");
+      ASSERT_STRICT_ALWAYS(std::fseek(f.get(), long(h.data_offset), SEEK_SET) == 0);
+      detail::check_remaining_elements<T>(f.get(), index_t{h.dims[0]}, index_t{h.dims[1]});
+      return f;
+   }
+
+#ifdef __linux__
+   template <Builtin T>
+   const BinaryHeader& mapped_entry(const std::string& name, long int rank) {
+      const BinaryHeader& h = this->entry<T>(name, rank);
+      ASSERT_STRICT_ALWAYS_MSG(bool(h.little_endian) == detail::native_little_endian,
+                               "Archive with different byte order cannot be mapped.\n");
+      if(!mapping_) {
+         mapping_.emplace(file_path_);
+      }
+      return h;
+   }
+#endif
+};
+
+
+}  // namespace spp
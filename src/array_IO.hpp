@@ -4,12 +4,20 @@
 #pragma once
 
 
+#include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 #include "ArrayCommon/array_traits.hpp"
@@ -18,6 +26,7 @@
 #include "array_ops.hpp"
 #include "derived1D.hpp"
 #include "derived2D.hpp"
+#include "mapped_file.hpp"
 
 
 namespace spp {
@@ -27,16 +36,16 @@ template <Builtin T, AlignmentFlag AF>
 std::istream& operator>>(std::istream& is, Array1D<T, AF>& A);
 
 
-template <Builtin T, AlignmentFlag AF>
-std::istream& operator>>(std::istream& is, Array2D<T, AF>& A);
+template <Builtin T, AlignmentFlag AF, Layout L>
+std::istream& operator>>(std::istream& is, Array2D<T, AF, L>& A);
 
 
 template <Builtin T, AlignmentFlag AF>
 void read_from_file(const std::string& file_path, Array1D<T, AF>& A);
 
 
-template <Builtin T, AlignmentFlag AF>
-void read_from_file(const std::string& file_path, Array2D<T, AF>& A);
+template <Builtin T, AlignmentFlag AF, Layout L>
+void read_from_file(const std::string& file_path, Array2D<T, AF, L>& A);
 
 
 std::ostream& operator<<(std::ostream& os, BaseType auto const& A);
@@ -104,95 +113,253 @@ inline detail::ArrayFormat array_format;
 namespace detail {
 
 
-template <Builtin T, AlignmentFlag AF>
-std::istream& istream_base_read(std::istream& is, Array1D<T, AF>& A) {
-   T x{};
-   index_t count{};
-
-   Array1D<T, AF> tmp(8);
-   while(is >> x) {
-      tmp.un(count++) = Strict{x};
-      if(tmp.size() == count) {
-         tmp.resize(2_sl * count);
-      }
+STRICT_INLINE bool is_text_space(char c) {
+   return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+
+STRICT_INLINE const char* skip_text_spaces(const char* first, const char* last) {
+   while(first != last && is_text_space(*first)) {
+      ++first;
    }
+   return first;
+}
 
-   ASSERT_STRICT_ALWAYS_MSG(is.eof(), "Invalid input.\n");
-   is.clear();
 
-   tmp.resize(count);
-   A.swap(tmp);
-   return is;
+STRICT_INLINE const char* skip_text_token(const char* first, const char* last) {
+   while(first != last && !is_text_space(*first)) {
+      ++first;
+   }
+   return first;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-void get_first_row(const std::string& line, Array2D<T, AF>& A) {
-   A.resize(1, 4);
-
-   T x{};
-   std::istringstream iss{line};
-   index_t ncols{};
-   while(iss >> x) {
-      A(0, ncols++) = Strict{x};
-      if(A.cols() == ncols) {
-         A.resize(1, 2_sl * ncols);
-      }
+// Numbers may be preceded by '+', as printed by operator<<.
+STRICT_INLINE const char* skip_text_plus(const char* first, const char* last) {
+   if(first != last && *first == '+' && last - first > 1 && first[1] != '-') {
+      return first + 1;
    }
-   if(ncols != 0_sl) {
-      A.resize(1, ncols);
+   return first;
+}
+
+
+template <StandardFloating T>
+bool parse_text_subnormal(const char* first, const char* last, T& x) {
+   const std::string s(first, last);
+   char* end;
+   if constexpr(SameAs<T, float>) {
+      x = std::strtof(s.c_str(), &end);
+   } else if constexpr(SameAs<T, double>) {
+      x = std::strtod(s.c_str(), &end);
    } else {
-      A.resize(0, 0);
+      x = std::strtold(s.c_str(), &end);
    }
+   return end == s.c_str() + s.size() && std::fpclassify(x) == FP_SUBNORMAL;
+}
+
 
-   ASSERT_STRICT_ALWAYS_MSG(iss.eof(), "Invalid input.\n");
-   iss.clear();
+// Parses the token [first, last). Booleans are given by 0, 1, false, or true. Returns false
+// if the token is not a valid number of type T.
+template <NotQuadruple T>
+bool parse_text_number(const char* first, const char* last, T& x) {
+   first = skip_text_plus(first, last);
+   if constexpr(Boolean<T>) {
+      const std::string_view s(first, std::size_t(last - first));
+      x = s == "1" || s == "true";
+      return x || s == "0" || s == "false";
+   } else {
+      const auto [ptr, ec] = std::from_chars(first, last, x);
+      if constexpr(StandardFloating<T>) {
+         // Some implementations reject subnormal numbers.
+         if(ec == std::errc::result_out_of_range && ptr == last) {
+            return parse_text_subnormal(first, last, x);
+         }
+      }
+      return ec == std::errc{} && ptr == last;
+   }
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-void get_row(const std::string& line, index_t row, Array2D<T, AF>& A) {
-   T x{};
-   std::istringstream iss{line};
-   index_t ncols{};
-   while(iss >> x) {
-      A(row, ncols++) = Strict{x};
+#ifdef STRICT_QUAD_PRECISION
+template <Quadruple T>
+bool parse_text_number(const char* first, const char* last, T& x) {
+   // strtoflt128 requires a null-terminated string.
+   const std::string s(skip_text_plus(first, last), last);
+   char* end;
+   x = strtoflt128(s.c_str(), &end);
+   return !s.empty() && end == s.c_str() + s.size();
+}
+#endif
+
+
+inline index_t count_text_tokens(const char* first, const char* last) {
+   index_t n{};
+   while((first = skip_text_spaces(first, last)) != last) {
+      first = skip_text_token(first, last);
+      ++n;
    }
+   return n;
+}
+
 
-   ASSERT_STRICT_ALWAYS(ncols == A.cols());
-   ASSERT_STRICT_ALWAYS_MSG(iss.eof(), "Invalid input.\n");
-   iss.clear();
+// Number of lines that contain at least one token.
+inline index_t count_text_rows(const char* first, const char* last) {
+   index_t n{};
+   while((first = skip_text_spaces(first, last)) != last) {
+      first = std::find(first, last, '\n');
+      ++n;
+   }
+   return n;
+}
+
+
+// Splits [first, last) into nchunks pieces which begin at the beginning of a line, or of a
+// token if lines is false, so that pieces can be counted and parsed independently.
+inline std::vector<const char*> split_text(const char* first, const char* last, long int nchunks,
+                                           bool lines) {
+   std::vector<const char*> bounds(std::size_t(nchunks + 1), last);
+   bounds[0] = first;
+   for(long int k = 1; k < nchunks; ++k) {
+      const char* p = std::max(bounds[std::size_t(k - 1)], first + (last - first) * k / nchunks);
+      while(p != first && p != last && (lines ? p[-1] != '\n' : !is_text_space(p[-1]))) {
+         ++p;
+      }
+      bounds[std::size_t(k)] = p;
+   }
+   return bounds;
+}
+
+
+// Counts elements of every piece in parallel and returns the index of the first element of
+// each piece, the last entry being the total count.
+template <typename F>
+std::vector<index_t> count_text(const std::vector<const char*>& bounds, F count) {
+   const long int nchunks = long(bounds.size()) - 1;
+   std::vector<index_t> offsets(bounds.size());
+   parallel_run(nchunks, [&](long int k) {
+      offsets[std::size_t(k + 1)] = count(bounds[std::size_t(k)], bounds[std::size_t(k + 1)]);
+   });
+   std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+   return offsets;
 }
 
 
 template <Builtin T, AlignmentFlag AF>
-std::istream& istream_base_read(std::istream& is, Array2D<T, AF>& A) {
-   std::string line{};
-   Array2D<T, AF> tmp;
-   // Important to test tmp.empty() first, otherwise get off-by-1 error.
-   while(tmp.empty() && std::getline(is, line)) {
-      get_first_row<T>(line, tmp);
-   }
-
-   if(!tmp.empty()) {
-      const index_t ncols = tmp.cols();
-      index_t row_count = 1_sl;
-
-      tmp.resize(2, ncols);
-      while(std::getline(is, line)) {
-         if(line.empty()) {
-            continue;
-         }
-         get_row<T>(line, row_count, tmp);
-         ++row_count;
-         if(tmp.rows() == row_count) {
-            tmp.resize(2_sl * row_count, ncols);
-         }
+void parse_text_elements(const char* first, const char* last, index_t i, Array1D<T, AF>& A) {
+   while((first = skip_text_spaces(first, last)) != last) {
+      const char* token_end = skip_text_token(first, last);
+      T x{};
+      ASSERT_STRICT_ALWAYS_MSG(parse_text_number(first, token_end, x), "Invalid input.\n");
+      A.un(i) = Strict{x};
+      ++i;
+      first = token_end;
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+void parse_text_rows(const char* first, const char* last, index_t row, Array2D<T, AF, L>& A) {
+   while((first = skip_text_spaces(first, last)) != last) {
+      const char* line_end = std::find(first, last, '\n');
+      index_t ncols{};
+      while((first = skip_text_spaces(first, line_end)) != line_end) {
+         ASSERT_STRICT_ALWAYS(ncols < A.cols());
+         const char* token_end = skip_text_token(first, line_end);
+         T x{};
+         ASSERT_STRICT_ALWAYS_MSG(parse_text_number(first, token_end, x), "Invalid input.\n");
+         A.un(row, ncols) = Strict{x};
+         ++ncols;
+         first = token_end;
       }
-      tmp.resize(row_count, ncols);
+      ASSERT_STRICT_ALWAYS(ncols == A.cols());
+      ++row;
+      first = line_end;
    }
+}
+
+
+// Elements are separated by whitespace. The text is split across threads, each of which
+// first counts and then parses its elements directly into the array.
+template <Builtin T, AlignmentFlag AF>
+void parse_text(const char* first, const char* last, Array1D<T, AF>& A) {
+   const long int nchunks = parallel_read_chunks(to_index_t(last - first));
+   const auto bounds = split_text(first, last, nchunks, false);
+   const auto offsets = count_text(bounds, count_text_tokens);
+
+   Array1D<T, AF> tmp(offsets.back(), uninitialized);
+   parallel_run(nchunks, [&](long int k) {
+      const auto c = std::size_t(k);
+      parse_text_elements(bounds[c], bounds[c + 1], offsets[c], tmp);
+   });
+   A.swap(tmp);
+}
 
+
+// Rows are separated by newlines and must have the same number of elements. Blank lines
+// are skipped.
+template <Builtin T, AlignmentFlag AF, Layout L>
+void parse_text(const char* first, const char* last, Array2D<T, AF, L>& A) {
+   const char* row = skip_text_spaces(first, last);
+   const index_t ncols = count_text_tokens(row, std::find(row, last, '\n'));
+
+   const long int nchunks = parallel_read_chunks(to_index_t(last - first));
+   const auto bounds = split_text(first, last, nchunks, true);
+   const auto offsets = count_text(bounds, count_text_rows);
+
+   Array2D<T, AF, L> tmp(offsets.back(), ncols, uninitialized);
+   parallel_run(nchunks, [&](long int k) {
+      const auto c = std::size_t(k);
+      parse_text_rows(bounds[c], bounds[c + 1], offsets[c], tmp);
+   });
    A.swap(tmp);
+}
+
+
+// Contents of a text file, which is mapped into memory where supported and read at once
+// otherwise.
+class TextFile {
+public:
+#ifdef __linux__
+   explicit TextFile(const std::string& file_path) : file_{file_path} {
+      file_.advise(MapAdvice::Sequential);
+   }
+
+   const char* begin() const {
+      return file_.data<char>();
+   }
+
+   const char* end() const {
+      return this->begin() + file_.size();
+   }
+
+private:
+   MappedFile file_;
+#else
+   explicit TextFile(const std::string& file_path) {
+      std::ifstream ifs{file_path, std::ios::binary};
+      ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
+      text_.assign(std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{});
+   }
+
+   const char* begin() const {
+      return text_.data();
+   }
+
+   const char* end() const {
+      return text_.data() + text_.size();
+   }
+
+private:
+   std::string text_;
+#endif
+};
+
+
+// Reads the remaining contents of the stream.
+template <typename Array>
+std::istream& istream_base_read(std::istream& is, Array& A) {
+   const std::string text{std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{}};
+   parse_text(text.data(), text.data() + text.size(), A);
    return is;
 }
 
@@ -201,7 +368,7 @@ auto count_digit(Real auto number) -> int {
    if(number == 0) {
       return 1;
    }
-   return static_cast<int>(std::log10(number)) + 1;
+   return static_cast<int>(std::log10(static_cast<long double>(number))) + 1;
 };
 
 
@@ -218,49 +385,10 @@ const auto floating_spacing = []<Floating T>(Strict<T> x) -> int {
 };
 
 
-STRICT_INLINE std::string smart_spaces(index_t maxi, index_t i) {
+STRICT_INLINE std::size_t smart_spaces(index_t maxi, index_t i) {
    int max_digits = count_digit(maxi.val());
    int ind_digits = count_digit(i.val());
-   return std::string(static_cast<std::string::size_type>(1 + max_digits - ind_digits), 32);
-}
-
-
-std::ostream& ostream_base_print(std::ostream& os, OneDimBaseType auto const& A,
-                                 const std::string& name) {
-   if(!name.empty()) {
-      os << name << ':' << '\n';
-   }
-
-   if(array_format.detailed_ && A.empty()) {
-      os << "[]\n";
-   }
-
-   if(array_format.style_ == ArrayFormat::Style::Column) {
-      if(!array_format.detailed_) {
-         for(auto i : irange(A)) {
-            os << A.un(i) << '\n';
-         }
-      } else {
-         for(auto i : irange(A)) {
-            os << "[" << i.sul() << "] =" << smart_spaces(A.size(), i) << A.un(i) << '\n';
-         }
-      }
-   } else {
-      if(!array_format.detailed_) {
-         for(auto i : irange(A)) {
-            auto spaces = i == A.size_m1() ? "" : "  ";
-            os << A.un(i) << spaces;
-         }
-      } else {
-         for(auto i : irange(A)) {
-            auto spaces = i == A.size_m1() ? "" : "  ";
-            os << "[" << i.sul() << "] =" << " " << A.un(i) << spaces;
-         }
-      }
-      os << '\n';
-   }
-
-   return os << std::flush;
+   return static_cast<std::size_t>(1 + max_digits - ind_digits);
 }
 
 
@@ -280,24 +408,154 @@ auto max_if_needed(TwoDimBaseType auto const& A) {
 }
 
 
-std::ostream& set_width_if_needed(std::ostream& os, TwoDimBaseType auto const& A, auto max_abs) {
+// Width of the field of each element, 0 if elements are not aligned.
+std::size_t text_width(TwoDimBaseType auto const& A) {
    using builtin_type = BuiltinTypeOf<decltype(A)>;
    if constexpr(Boolean<builtin_type>) {
-      return os << std::setw(boolean_spacing());
+      return std::size_t(boolean_spacing());
 
    } else if constexpr(Integer<builtin_type>) {
-      return os << std::setw(integer_spacing(max_abs));
+      return std::size_t(integer_spacing(max_if_needed(A)));
 
    } else {
-      if(format.is_scientific()) {
-         return os;
+      if(format.is_scientific() || format.is_shortest()) {
+         return 0;
       } else {
-         return os << std::setw(floating_spacing(max_abs));
+         return std::size_t(floating_spacing(max_if_needed(A)));
+      }
+   }
+}
+
+
+// Characters are formatted directly into the buffer, which grows as needed.
+class TextBuffer {
+public:
+   void clear() {
+      size_ = 0;
+   }
+
+   const char* data() const {
+      return data_.data();
+   }
+
+   std::size_t size() const {
+      return size_;
+   }
+
+   void append(std::string_view s) {
+      std::memcpy(this->reserve(s.size()), s.data(), s.size());
+      size_ += s.size();
+   }
+
+   void append_spaces(std::size_t count) {
+      std::memset(this->reserve(count), ' ', count);
+      size_ += count;
+   }
+
+   void append_index(index_t i) {
+      char* p = this->reserve(24);
+      size_ += std::size_t(std::to_chars(p, p + 24, i.val()).ptr - p);
+   }
+
+   // Formats x as operator<< does, right-aligned in a field of the given width.
+   template <Builtin T>
+   void append_number(T x, std::size_t width = 0) {
+      const std::size_t first = size_;
+      for(std::size_t n = 64;; n *= 4) {
+         char* p = this->reserve(n);
+         if(const auto r = format_chars(p, p + n, x); r.ec == std::errc{}) {
+            size_ += std::size_t(r.ptr - p);
+            break;
+         }
+      }
+      if(const std::size_t len = size_ - first; len < width) {
+         this->reserve(width - len);
+         char* p = data_.data() + first;
+         std::memmove(p + (width - len), p, len);
+         std::memset(p, ' ', width - len);
+         size_ += width - len;
+      }
+   }
+
+private:
+   std::vector<char> data_;
+   std::size_t size_{};
+
+   char* reserve(std::size_t n) {
+      if(data_.size() - size_ < n) {
+         data_.resize(std::max(2 * data_.size(), size_ + n));
+      }
+      return data_.data() + size_;
+   }
+};
+
+
+// Number of elements formatted into a buffer before it is written to the stream.
+inline constexpr index_t text_block_size{1L << 14};
+
+
+// Formats units [0, n), i.e. elements or rows, by calling format_unit(buffer, i) and writes
+// them to os in order. Units are formatted in blocks so that buffers remain small. Each of
+// nchunks threads formats one block per round, blocks are written in order after the round.
+template <typename F>
+void write_text(std::ostream& os, index_t n, index_t block, long int nchunks, F format_unit) {
+   std::vector<TextBuffer> buffers(static_cast<std::size_t>(nchunks));
+   for(index_t first = 0_sl; first < n; first += block * index_t{nchunks}) {
+      parallel_run(nchunks, [&](long int k) {
+         auto& buffer = buffers[std::size_t(k)];
+         buffer.clear();
+         const index_t chunk_first = mins(first + block * index_t{k}, n);
+         const index_t chunk_last = mins(chunk_first + block, n);
+         for(index_t i = chunk_first; i < chunk_last; ++i) {
+            format_unit(buffer, i);
+         }
+      });
+      for(const auto& buffer : buffers) {
+         os.write(buffer.data(), std::streamsize(buffer.size()));
       }
    }
 }
 
 
+std::ostream& ostream_base_print(std::ostream& os, OneDimBaseType auto const& A,
+                                 const std::string& name) {
+   if(!name.empty()) {
+      os << name << ':' << '\n';
+   }
+
+   if(array_format.detailed_ && A.empty()) {
+      os << "[]\n";
+   }
+
+   const bool column = array_format.style_ == ArrayFormat::Style::Column;
+   const bool detailed = array_format.detailed_;
+   const long int nchunks = parallel_read_chunks<RemoveCVRef<decltype(A)>>(A.size());
+   write_text(os, A.size(), text_block_size, nchunks, [&](TextBuffer& buffer, index_t i) {
+      if(detailed) {
+         buffer.append("[");
+         buffer.append_index(i);
+         if(column) {
+            buffer.append("] =");
+            buffer.append_spaces(smart_spaces(A.size(), i));
+         } else {
+            buffer.append("] = ");
+         }
+      }
+      buffer.append_number(A.un(i).val());
+      if(column) {
+         buffer.append("\n");
+      } else if(i != A.size_m1()) {
+         buffer.append("  ");
+      }
+   });
+
+   if(!column) {
+      os << '\n';
+   }
+   return os << std::flush;
+}
+
+
 std::ostream& ostream_base_print(std::ostream& os, TwoDimBaseType auto const& A,
                                  const std::string& name) {
    if(!name.empty()) {
@@ -308,18 +566,27 @@ std::ostream& ostream_base_print(std::ostream& os, TwoDimBaseType auto const& A,
       os << "[]\n";
    }
 
-   auto max_abs = max_if_needed(A);
-
-   for(auto i : irange(A.rows())) {
+   const std::size_t width = text_width(A);
+   const bool detailed = array_format.detailed_;
+   const index_t block = maxs(1_sl, text_block_size / maxs(1_sl, A.cols()));
+   const long int nchunks = parallel_read_chunks<RemoveCVRef<decltype(A)>>(A.size());
+   write_text(os, A.rows(), block, nchunks, [&](TextBuffer& buffer, index_t i) {
       for(auto j : irange(A.cols())) {
-         auto post_space = j == A.cols_m1() ? "" : "  ";
-         if(array_format.detailed_) {
-            os << '[' << i.sul() << ", " << j.sul() << "] =" << smart_spaces(A.rows(), i);
+         if(detailed) {
+            buffer.append("[");
+            buffer.append_index(i);
+            buffer.append(", ");
+            buffer.append_index(j);
+            buffer.append("] =");
+            buffer.append_spaces(smart_spaces(A.rows(), i));
+         }
+         buffer.append_number(A.un(i, j).val(), width);
+         if(j != A.cols_m1()) {
+            buffer.append("  ");
          }
-         set_width_if_needed(os, A, max_abs) << A.un(i, j) << post_space;
       }
-      os << '\n';
-   }
+      buffer.append("\n");
+   });
 
    return os << std::flush;
 }
@@ -350,27 +617,23 @@ std::istream& operator>>(std::istream& is, Array1D<T, AF>& A) {
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-std::istream& operator>>(std::istream& is, Array2D<T, AF>& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+std::istream& operator>>(std::istream& is, Array2D<T, AF, L>& A) {
    return detail::istream_base_read(is, A);
 }
 
 
 template <Builtin T, AlignmentFlag AF>
 void read_from_file(const std::string& file_path, Array1D<T, AF>& A) {
-   std::ifstream ifs{file_path};
-   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
-   detail::istream_base_read(ifs, A);
-   ifs.close();
+   const detail::TextFile file{file_path};
+   detail::parse_text(file.begin(), file.end(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-void read_from_file(const std::string& file_path, Array2D<T, AF>& A) {
-   std::ifstream ifs{file_path};
-   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
-   detail::istream_base_read(ifs, A);
-   ifs.close();
+template <Builtin T, AlignmentFlag AF, Layout L>
+void read_from_file(const std::string& file_path, Array2D<T, AF, L>& A) {
+   const detail::TextFile file{file_path};
+   detail::parse_text(file.begin(), file.end(), A);
 }
 
 
@@ -4,7 +4,11 @@
 #pragma once
 
 
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
 #include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -30,6 +34,9 @@ public:
    using value_type = Strict<T>;
    using builtin_type = T;
 
+   // data() is aligned to alignment bytes, see STRICT_ALIGNMENT.
+   static constexpr std::size_t alignment = std::size_t(detail::alignment_of<T, AF>());
+
    // Constructors.
    STRICT_NODISCARD_CONSTEXPR ArrayBase1D();
    STRICT_NODISCARD explicit ArrayBase1D(ImplicitInt n)
@@ -37,6 +44,8 @@ public:
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n)
       requires(AF == Unaligned);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(Size n);
+   STRICT_NODISCARD explicit ArrayBase1D(ImplicitInt n, detail::Uninitialized);
+   STRICT_NODISCARD explicit ArrayBase1D(ImplicitInt n, detail::FirstTouch);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n, value_type x);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(Size n, Value<T> x);
    STRICT_NODISCARD_CONSTEXPR ArrayBase1D(use::List1D<builtin_type> list);
@@ -63,7 +72,20 @@ public:
    STRICT_CONSTEXPR void swap(ArrayBase1D& A) noexcept;
    STRICT_CONSTEXPR void swap(ArrayBase1D&& A) noexcept;
 
+   // Elements are allocated from the memory resource of the calling thread at construction,
+   // including default construction, see ScopedMemoryResource. resize, reserve, insert and remove keep allocating from it,
+   // whereas resize_and_assign replaces the array by a newly constructed one.
+   STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* resource() const;
+
+   // Elements are stored in a buffer of capacity() >= size() elements. Growing beyond the
+   // capacity, reserve and shrink_to_fit reallocate the buffer, which invalidates pointers
+   // and iterators. The capacity grows geometrically, so that inserting elements one at a
+   // time takes amortized constant time. Otherwise, remove and insert move elements within
+   // the buffer, which invalidates pointers and iterators from the position on. Shrinking
+   // keeps the capacity. New elements, and all elements if preserve is false, are zero.
    STRICT_CONSTEXPR auto& resize(ImplicitInt n, ImplicitBool preserve = true);
+   STRICT_CONSTEXPR auto& reserve(ImplicitInt n);
+   STRICT_CONSTEXPR auto& shrink_to_fit();
 
    STRICT_CONSTEXPR auto& resize_and_assign(OneDimBaseType auto const& A);
 
@@ -96,10 +118,16 @@ public:
 
    ////////////////////////////////////////////////////////////////////////////////////////////////////
    STRICT_CONSTEXPR_INLINE index_t size() const;
+   STRICT_CONSTEXPR_INLINE index_t capacity() const;
 
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i) const;
 
+   STRICT_NODISCARD_INLINE Packet<T> load_packet(ImplicitInt i) const
+      requires PacketBuiltin<T>;
+   STRICT_INLINE void store_packet(ImplicitInt i, Packet<T> x)
+      requires PacketBuiltin<T>;
+
    STRICT_NODISCARD_CONSTEXPR value_type* data() &;
    STRICT_NODISCARD_CONSTEXPR const value_type* data() const&;
    STRICT_NODISCARD_CONSTEXPR value_type* data() && = delete;
@@ -122,12 +150,28 @@ public:
 private:
    value_type* data_;
    index_t n_;
+   index_t cap_;
+   std::pmr::memory_resource* res_;
+
+   template <Builtin, AlignmentFlag, Layout>
+   friend class ArrayBase2D;
+
+   static value_type* allocate_uninitialized(index_t n, std::pmr::memory_resource* r);
+   static STRICT_CONSTEXPR value_type* allocate(index_t n, std::pmr::memory_resource* r);
+   STRICT_CONSTEXPR void deallocate();
+   static STRICT_CONSTEXPR ArrayBase1D with_resource(index_t n, std::pmr::memory_resource* r);
+
+   STRICT_CONSTEXPR void reallocate(index_t cap);
+   STRICT_CONSTEXPR void grow(index_t n);
+   STRICT_CONSTEXPR void open(index_t pos, index_t count);
 };
 
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D() : data_{nullptr},
-                                                               n_{} {
+                                                               n_{},
+                                                               cap_{},
+                                                               res_{current_memory_resource()} {
 }
 
 
@@ -135,11 +179,11 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n)
    requires(AF == Aligned)
     : data_{nullptr},
-      n_{n.get()} {
+      n_{n.get()},
+      cap_{n.get()},
+      res_{current_memory_resource()} {
    ASSERT_STRICT_DEBUG(n_ > -1_sl);
-   if(n_ != 0_sl) {
-      data_ = new(std::align_val_t{detail::alignment_of<T, AF>()}) value_type[to_size_t(n_)];
-   }
+   data_ = allocate(n_, res_);
 }
 
 
@@ -147,16 +191,45 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n)
    requires(AF == Unaligned)
     : data_{nullptr},
-      n_{n.get()} {
+      n_{n.get()},
+      cap_{n.get()},
+      res_{current_memory_resource()} {
+   ASSERT_STRICT_DEBUG(n_ > -1_sl);
+   data_ = allocate(n_, res_);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(Size n) : ArrayBase1D(n.get()) {
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n, detail::Uninitialized)
+    : data_{nullptr},
+      n_{n.get()},
+      cap_{n.get()},
+      res_{current_memory_resource()} {
    ASSERT_STRICT_DEBUG(n_ > -1_sl);
    if(n_ != 0_sl) {
-      data_ = new value_type[to_size_t(n_)];
+      data_ = allocate_uninitialized(n_, res_);
    }
 }
 
 
+// Chunks are the same as in parallel_for used by parallel operations on n elements.
 template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(Size n) : ArrayBase1D(n.get()) {
+STRICT_NODISCARD ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n, detail::FirstTouch)
+    : ArrayBase1D(n, uninitialized) {
+   auto* p = data_;
+   auto zero = [p](index_t first, index_t last) {
+      std::uninitialized_default_construct(p + first.val(), p + last.val());
+   };
+   if(use_parallel_read<>(n_)) {
+      parallel_for(n_, parallel_grain, zero);
+   } else {
+      zero(0_sl, n_);
+   }
 }
 
 
@@ -200,7 +273,9 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(const ArrayBase1D& A)
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ArrayBase1D&& A) noexcept
     : data_{std::exchange(A.data_, nullptr)},
-      n_{std::exchange(A.n_, 0_sl)} {
+      n_{std::exchange(A.n_, 0_sl)},
+      cap_{std::exchange(A.cap_, 0_sl)},
+      res_{std::exchange(A.res_, nullptr)} {
 }
 
 
@@ -259,7 +334,7 @@ template <Builtin T, AlignmentFlag AF>
 ArrayBase1D<T, AF>::~ArrayBase1D()
    requires(AF == Aligned)
 {
-   operator delete[](data_, std::align_val_t{detail::alignment_of<T, AF>()});
+   deallocate();
 }
 
 
@@ -267,7 +342,7 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR ArrayBase1D<T, AF>::~ArrayBase1D()
    requires(AF == Unaligned)
 {
-   delete[] data_;
+   deallocate();
 }
 
 
@@ -275,6 +350,8 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR void ArrayBase1D<T, AF>::swap(ArrayBase1D& A) noexcept {
    std::swap(data_, A.data_);
    std::swap(n_, A.n_);
+   std::swap(cap_, A.cap_);
+   std::swap(res_, A.res_);
 }
 
 
@@ -288,17 +365,131 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize(ImplicitInt n, ImplicitBool preserve) {
    ASSERT_STRICT_DEBUG(n.get() > -1_sl);
 
-   if(auto n_new = n.get(); n_new != n_) {
-      ArrayBase1D tmp(n_new);
-      if(preserve.get()) {
-         copyn(*this, tmp, mins(n_, n_new));
+   const auto n_new = n.get();
+   if(n_new > cap_) {
+      if(!preserve.get()) {
+         n_ = 0_sl;
       }
-      this->swap(tmp);
+      grow(n_new);
+   } else if(!preserve.get()) {
+      std::fill(data_, data_ + n_new.val(), value_type{});
+   } else if(n_new > n_) {
+      std::fill(data_ + n_.val(), data_ + n_new.val(), value_type{});
    }
+   n_ = n_new;
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::reserve(ImplicitInt n) {
+   ASSERT_STRICT_DEBUG(n.get() > -1_sl);
+   if(n.get() > cap_) {
+      reallocate(n.get());
+   }
+   return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::shrink_to_fit() {
+   if(cap_ != n_) {
+      reallocate(n_);
+   }
+   return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
+}
+
+
+// Elements of trivially copyable Strict<T> begin their lifetime implicitly in the
+// allocated storage, but their values are indeterminate.
+template <Builtin T, AlignmentFlag AF>
+auto ArrayBase1D<T, AF>::allocate_uninitialized(index_t n, std::pmr::memory_resource* r)
+    -> value_type* {
+   const std::size_t bytes = to_size_t(n) * sizeof(value_type);
+   if(r != nullptr) {
+      return static_cast<value_type*>(r->allocate(bytes, alignment));
+   } else if constexpr(AF == Aligned) {
+      return static_cast<value_type*>(
+          operator new[](bytes, std::align_val_t{alignment}));
+   } else {
+      return static_cast<value_type*>(operator new[](bytes));
+   }
+}
+
+
+// Elements are value-initialized, i.e. zero, as with new value_type[n], which is used at
+// compile time.
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto ArrayBase1D<T, AF>::allocate(index_t n, std::pmr::memory_resource* r)
+    -> value_type* {
+   if(n == 0_sl) {
+      return nullptr;
+   }
+   if(std::is_constant_evaluated()) {
+      return new value_type[to_size_t(n)];
+   }
+   auto* p = allocate_uninitialized(n, r);
+   std::uninitialized_default_construct_n(p, to_size_t(n));
+   return p;
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::deallocate() {
+   if(std::is_constant_evaluated()) {
+      delete[] data_;
+   } else if(data_ == nullptr) {
+      return;
+   } else if(res_ != nullptr) {
+      res_->deallocate(data_, to_size_t(cap_) * sizeof(value_type), alignment);
+   } else if constexpr(AF == Aligned) {
+      operator delete[](data_, std::align_val_t{alignment});
+   } else {
+      operator delete[](data_);
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto ArrayBase1D<T, AF>::with_resource(index_t n, std::pmr::memory_resource* r)
+    -> ArrayBase1D {
+   ArrayBase1D A;
+   A.data_ = allocate(n, r);
+   A.n_ = n;
+   A.cap_ = n;
+   A.res_ = r;
+   return A;
+}
+
+
+// Elements beyond the size are zero after reallocation.
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::reallocate(index_t cap) {
+   ArrayBase1D tmp = with_resource(cap, res_);
+   copyn(*this, tmp, n_);
+   tmp.n_ = n_;
+   this->swap(tmp);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::grow(index_t n) {
+   if(n > cap_) {
+      reallocate(maxs(n, 2_sl * cap_));
+   }
+}
+
+
+// Shifts elements starting at pos by count positions to the end, growing the capacity if
+// needed. Elements pos, ..., pos + count - 1 are left to be assigned by the caller.
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::open(index_t pos, index_t count) {
+   grow(n_ + count);
+   std::copy_backward(data_ + pos.val(), data_ + n_.val(), data_ + (n_ + count).val());
+   n_ += count;
+}
+
+
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize_and_assign(OneDimBaseType auto const& A) {
    ArrayBase1D tmp(A);
@@ -322,10 +513,8 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(ImplicitInt pos, ImplicitInt c
    ASSERT_STRICT_DEBUG(valid_index(*this, pos.get()));
    ASSERT_STRICT_DEBUG(valid_index(*this, pos.get() + count.get() - 1_sl));
 
-   ArrayBase1D tmp(this->size() - count.get());
-   copyn(*this, tmp, pos.get());
-   copyn(*this, tmp, pos.get() + count.get(), pos.get(), this->size() - pos.get() - count.get());
-   this->swap(tmp);
+   std::copy(data_ + (pos.get() + count.get()).val(), data_ + n_.val(), data_ + pos.get().val());
+   n_ -= count.get();
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
@@ -368,15 +557,14 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(Last lst) {
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(const std::vector<ImplicitInt>& indexes) {
+   ASSERT_STRICT_DEBUG(valid_complement_index_vector(
+       valid_index<RemoveCVRef<decltype(*this)>>, *this, indexes));
    if(!indexes.empty()) {
-      auto ci = complement_index_vector(
-          valid_index<RemoveCVRef<decltype(*this)>>, this->size(), *this, indexes);
-      ArrayBase1D tmp(to_index_t(ci.size()));
-
-      for(index_t i = 0_sl; i < tmp.size(); ++i) {
-         tmp.un(i) = (*this).un(ci[to_size_t(i)]);
-      }
-      this->swap(tmp);
+      n_ = for_each_complement_index(n_, indexes, [this](index_t i, index_t k) {
+         if(i != k) {
+            data_[k.val()] = data_[i.val()];
+         }
+      });
    }
 
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
@@ -387,12 +575,8 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(const std::vector<ImplicitInt>
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert(ImplicitInt pos, value_type x) {
    ASSERT_STRICT_DEBUG(pos.get() >= 0_sl && pos.get() <= this->size());
-   ArrayBase1D tmp(this->size() + 1_sl);
-   copyn(*this, tmp, pos.get());
-   tmp.un(pos.get()) = x;
-   copyn(*this, tmp, pos.get(), pos.get() + 1_sl, this->size() - pos.get());
-
-   this->swap(tmp);
+   open(pos.get(), 1_sl);
+   data_[pos.get().val()] = x;
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
@@ -430,12 +614,21 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert_back(Value<builtin_type> x) {
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert(ImplicitInt pos, OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(pos.get() >= 0_sl && pos.get() <= this->size());
-   ArrayBase1D tmp(this->size() + A.size());
-   copyn(*this, tmp, pos.get());
-   copyn(A, tmp, 0_sl, pos.get(), A.size());
-   copyn(*this, tmp, pos.get(), pos.get() + A.size(), this->size() - pos.get());
-
-   this->swap(tmp);
+   const index_t count = A.size();
+   // A may refer to this array. Appended elements are copied before the size is updated,
+   // otherwise A is evaluated before elements are shifted.
+   if(pos.get() == n_) {
+      grow(n_ + count);
+      copyn(A, *this, 0_sl, n_, count);
+      n_ += count;
+   } else if(distinct_array(A, *this)) {
+      open(pos.get(), count);
+      copyn(A, *this, 0_sl, pos.get(), count);
+   } else {
+      const ArrayBase1D B(A);
+      open(pos.get(), count);
+      copyn(B, *this, 0_sl, pos.get(), count);
+   }
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
@@ -465,6 +658,18 @@ STRICT_CONSTEXPR_INLINE index_t ArrayBase1D<T, AF>::size() const {
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase1D<T, AF>::capacity() const {
+   return cap_;
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* ArrayBase1D<T, AF>::resource() const {
+   return res_;
+}
+
+
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase1D<T, AF>::un(ImplicitInt i) -> value_type& {
    return data_[i.get().val()];
@@ -478,6 +683,22 @@ STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase1D<T, AF>::un(ImplicitInt i) con
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_INLINE auto ArrayBase1D<T, AF>::load_packet(ImplicitInt i) const -> Packet<T>
+   requires PacketBuiltin<T>
+{
+   return detail::load_packet<AF>(data_ + i.get().val());
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_INLINE void ArrayBase1D<T, AF>::store_packet(ImplicitInt i, Packet<T> x)
+   requires PacketBuiltin<T>
+{
+   detail::store_packet<AF>(data_ + i.get().val(), x);
+}
+
+
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR auto ArrayBase1D<T, AF>::data() & -> value_type* {
    return this->size() != 0_sl ? data_ : nullptr;
@@ -4,6 +4,8 @@
 #pragma once
 
 
+#include <algorithm>
+#include <memory_resource>
 #include <utility>
 #include <vector>
 
@@ -24,16 +26,23 @@ namespace detail {
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
+// Elements are stored in row-major or column-major order depending on L. Column-major arrays
+// are evaluated column by column and provide col_data(j), but they are not read or written in
+// packets, since packets follow the row-major order of un(i).
+template <Builtin T, AlignmentFlag AF, Layout L = RowMajor>
 class STRICT_NODISCARD ArrayBase2D : private ReferenceBase2D, private TwoDimArrayBase {
 public:
    using value_type = Strict<T>;
    using builtin_type = T;
 
+   static constexpr std::size_t alignment = ArrayBase1D<T, AF>::alignment;
+
    // Constructors.
    STRICT_NODISCARD_CONSTEXPR ArrayBase2D() = default;
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(Rows m, Cols n);
+   STRICT_NODISCARD explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, detail::Uninitialized);
+   STRICT_NODISCARD explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, detail::FirstTouch);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, value_type x);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(Rows m, Cols n, Value<T> x);
    STRICT_NODISCARD_CONSTEXPR ArrayBase2D(use::List2D<builtin_type> list);
@@ -116,12 +125,32 @@ public:
    STRICT_CONSTEXPR_INLINE index_t rows() const;
    STRICT_CONSTEXPR_INLINE index_t cols() const;
    STRICT_CONSTEXPR_INLINE index_t size() const;
+   STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* resource() const;
 
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i) const;
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i, ImplicitInt j);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i, ImplicitInt j) const;
 
+   STRICT_NODISCARD_INLINE Packet<T> load_packet(ImplicitInt i) const
+      requires(PacketBuiltin<T> && L == RowMajor);
+   STRICT_INLINE void store_packet(ImplicitInt i, Packet<T> x)
+      requires(PacketBuiltin<T> && L == RowMajor);
+
+   STRICT_NODISCARD_CONSTEXPR value_type* col_data(ImplicitInt j) &
+      requires(L == ColMajor);
+   STRICT_NODISCARD_CONSTEXPR const value_type* col_data(ImplicitInt j) const&
+      requires(L == ColMajor);
+   STRICT_NODISCARD_CONSTEXPR value_type* col_data(ImplicitInt j) && = delete;
+   STRICT_NODISCARD_CONSTEXPR const value_type* col_data(ImplicitInt j) const&& = delete;
+
+   // Elements in the order of L, which row(), col() and diag() of column-major arrays are
+   // sliced from.
+   STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>& storage() &
+      requires(L == ColMajor);
+   STRICT_NODISCARD_CONSTEXPR const ArrayBase1D<T, AF>& storage() const&
+      requires(L == ColMajor);
+
    STRICT_NODISCARD_CONSTEXPR value_type* data() &;
    STRICT_NODISCARD_CONSTEXPR const value_type* data() const&;
    STRICT_NODISCARD_CONSTEXPR value_type* data() && = delete;
@@ -144,11 +173,35 @@ public:
 private:
    FixedArrayBase1D<long int, 2, Unaligned> dims_;
    ArrayBase1D<T, AF> data1D_;
+
+   STRICT_CONSTEXPR static ArrayBase2D with_resource(index_t m, index_t n,
+                                                     std::pmr::memory_resource* r);
+
+   // Outer lines are stored one after another, each holding inner() consecutive elements:
+   // rows for RowMajor and columns for ColMajor.
+   static constexpr long int outer_dim = L == RowMajor ? 0L : 1L;
+   static constexpr long int inner_dim = 1L - outer_dim;
+
+   STRICT_CONSTEXPR_INLINE index_t outer() const;
+   STRICT_CONSTEXPR_INLINE index_t inner() const;
+
+   STRICT_CONSTEXPR void remove_outer(index_t pos, index_t count);
+   STRICT_CONSTEXPR void remove_inner(index_t pos, index_t count);
+   STRICT_CONSTEXPR void remove_outer(const std::vector<ImplicitInt>& indexes);
+   STRICT_CONSTEXPR void remove_inner(const std::vector<ImplicitInt>& indexes);
+   STRICT_CONSTEXPR void open_outer(index_t pos, index_t count);
+   STRICT_CONSTEXPR void open_inner(index_t pos, index_t count);
+   STRICT_CONSTEXPR void open_rows(index_t pos, index_t count);
+   STRICT_CONSTEXPR void open_cols(index_t pos, index_t count);
+   STRICT_CONSTEXPR void assign_row(index_t i, OneDimBaseType auto const& A);
+   STRICT_CONSTEXPR void assign_col(index_t j, OneDimBaseType auto const& A);
+   STRICT_CONSTEXPR void set_outer_inner(index_t outer, index_t inner);
+   STRICT_CONSTEXPR void set_dims(index_t m, index_t n);
 };
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(ImplicitInt m, ImplicitInt n)
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, L>::ArrayBase2D(ImplicitInt m, ImplicitInt n)
     : dims_{m.get(), n.get()},
       data1D_(m.get() * n.get()) {
    ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
@@ -157,66 +210,89 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(ImplicitInt m, Implic
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(Rows m, Cols n)
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, L>::ArrayBase2D(Rows m, Cols n)
     : ArrayBase2D(m.get(), n.get()) {
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD ArrayBase2D<T, AF, L>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                 detail::Uninitialized)
+    : dims_{m.get(), n.get()},
+      data1D_(m.get() * n.get(), uninitialized) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD ArrayBase2D<T, AF, L>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                 detail::FirstTouch)
+    : dims_{m.get(), n.get()},
+      data1D_(m.get() * n.get(), first_touch) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, L>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
                                                            value_type x)
     : ArrayBase2D(m, n) {
    data1D_ = x;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(Rows m, Cols n, Value<T> x)
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, L>::ArrayBase2D(Rows m, Cols n, Value<T> x)
     : ArrayBase2D(m.get(), n.get(), x.get()) {
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(use::List2D<builtin_type> list)
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, L>::ArrayBase2D(use::List2D<builtin_type> list)
     : ArrayBase2D(list2D_row_col_sizes(list).first, list2D_row_col_sizes(list).second) {
    ASSERT_STRICT_DEBUG(valid_list2D(list));
    copy(list, *this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(TwoDimBaseType auto const& A)
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, L>::ArrayBase2D(TwoDimBaseType auto const& A)
     : ArrayBase2D(A.rows(), A.cols()) {
    copy(A, *this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(value_type x) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, L>& ArrayBase2D<T, AF, L>::operator=(value_type x) {
    data1D_ = x;
    return *this;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(use::List2D<builtin_type> list) {
-   ArrayBase2D tmp(list);
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, L>& ArrayBase2D<T, AF, L>::operator=(use::List2D<builtin_type> list) {
+   // Elements are copied, so that the array keeps its memory resource.
+   const ArrayBase2D tmp(list);
    ASSERT_STRICT_DEBUG(same_size(*this, tmp));
-   return *this = std::move(tmp);
+   return *this = tmp;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(const ArrayBase2D& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, L>& ArrayBase2D<T, AF, L>::operator=(const ArrayBase2D& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
    data1D_ = A.data1D_;
    return *this;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(ArrayBase2D&& A) noexcept {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, L>& ArrayBase2D<T, AF, L>::operator=(ArrayBase2D&& A) noexcept {
    NORMAL_ASSERT_STRICT_DEBUG(same_size(*this, A));
    A.dims_ = 0_sl;
    data1D_ = std::move(A.data1D_);
@@ -224,29 +300,43 @@ STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(ArrayBase2D&&
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, L>& ArrayBase2D<T, AF, L>::operator=(TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
    copy(A, *this);
    return *this;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR void ArrayBase2D<T, AF>::swap(ArrayBase2D& A) noexcept {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::swap(ArrayBase2D& A) noexcept {
    dims_ = std::exchange(A.dims_, dims_);
    data1D_.swap(A.data1D_);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR void ArrayBase2D<T, AF>::swap(ArrayBase2D&& A) noexcept {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::swap(ArrayBase2D&& A) noexcept {
    this->swap(A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize(ImplicitInt m, ImplicitInt n,
+// Elements are zero and allocated from r rather than the memory resource of the calling
+// thread, so that resize keeps allocating from the resource of the array.
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto ArrayBase2D<T, AF, L>::with_resource(index_t m, index_t n,
+                                                         std::pmr::memory_resource* r)
+    -> ArrayBase2D {
+   ArrayBase2D A;
+   A.dims_.un(0) = m;
+   A.dims_.un(1) = n;
+   A.data1D_.swap(ArrayBase1D<T, AF>::with_resource(m * n, r));
+   return A;
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::resize(ImplicitInt m, ImplicitInt n,
                                                   ImplicitBool preserve) {
    ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
    ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
@@ -257,7 +347,7 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize(ImplicitInt m, ImplicitInt n,
 
    if(preserve.get()) {
       if(not(d0_new == dims_.un(0) && d1_new == dims_.un(1))) {
-         ArrayBase2D tmp(d0_new, d1_new);
+         ArrayBase2D tmp = with_resource(d0_new, d1_new, data1D_.resource());
          for(index_t i = 0_sl; i < mins(dims_.un(0), d0_new); ++i) {
             for(index_t j = 0_sl; j < mins(dims_.un(1), d1_new); ++j) {
                tmp.un(i, j) = this->un(i, j);
@@ -268,7 +358,7 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize(ImplicitInt m, ImplicitInt n,
    } else {
       if(not(d0_new == dims_.un(0) && d1_new == dims_.un(1))) {
          if(d0_new * d1_new != dims_.un(0) * dims_.un(1)) {
-            ArrayBase2D tmp(d0_new, d1_new);
+            ArrayBase2D tmp = with_resource(d0_new, d1_new, data1D_.resource());
             this->swap(tmp);
          } else {
             dims_.un(0) = d0_new;
@@ -281,16 +371,16 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize(ImplicitInt m, ImplicitInt n,
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize_and_assign(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::resize_and_assign(TwoDimBaseType auto const& A) {
    ArrayBase2D tmp(A);
    this->swap(tmp);
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize_and_assign(StrictArray2D<ArrayBase2D>&& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::resize_and_assign(StrictArray2D<ArrayBase2D>&& A) {
    this->swap(A);
    A.swap(ArrayBase2D{});
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
@@ -298,174 +388,158 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize_and_assign(StrictArray2D<Array
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(ImplicitInt row_pos, ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows(ImplicitInt row_pos, ImplicitInt count) {
    ASSERT_STRICT_DEBUG(count.get() > 0_sl);
    ASSERT_STRICT_DEBUG(valid_row(*this, row_pos.get()));
    ASSERT_STRICT_DEBUG(valid_row(*this, row_pos.get() + count.get() - 1_sl));
 
-   index_t new_rows = this->rows() - count.get();
-   ArrayBase2D tmp(new_rows, new_rows == 0_sl ? 0_sl : this->cols());
-   copy_rows(*this, tmp, row_pos.get());
-   copy_rows(*this,
-             tmp,
-             row_pos.get() + count.get(),
-             row_pos.get(),
-             this->rows() - row_pos.get() - count.get());
-   this->swap(tmp);
+   if constexpr(L == RowMajor) {
+      this->remove_outer(row_pos.get(), count.get());
+   } else {
+      this->remove_inner(row_pos.get(), count.get());
+   }
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(Pos row_pos, Count count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows(Pos row_pos, Count count) {
    return this->remove_rows(row_pos.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(ImplicitInt col_pos, ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols(ImplicitInt col_pos, ImplicitInt count) {
    ASSERT_STRICT_DEBUG(count.get() > 0_sl);
    ASSERT_STRICT_DEBUG(valid_col(*this, col_pos.get()));
    ASSERT_STRICT_DEBUG(valid_col(*this, col_pos.get() + count.get() - 1_sl));
 
-   index_t new_cols = this->cols() - count.get();
-   ArrayBase2D tmp(new_cols == 0_sl ? 0_sl : this->rows(), new_cols);
-   copy_cols(*this, tmp, col_pos.get());
-   copy_cols(*this,
-             tmp,
-             col_pos.get() + count.get(),
-             col_pos.get(),
-             this->cols() - col_pos.get() - count.get());
-   this->swap(tmp);
+   if constexpr(L == RowMajor) {
+      this->remove_inner(col_pos.get(), count.get());
+   } else {
+      this->remove_outer(col_pos.get(), count.get());
+   }
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(Pos col_pos, Count count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols(Pos col_pos, Count count) {
    return this->remove_cols(col_pos.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_row(ImplicitInt row_pos) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_row(ImplicitInt row_pos) {
    return this->remove_rows(row_pos, 1);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_row(Pos row_pos) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_row(Pos row_pos) {
    return this->remove_row(row_pos.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_row([[maybe_unused]] Last lst) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_row([[maybe_unused]] Last lst) {
    return this->remove_row(this->rows() - 1_sl);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_col(ImplicitInt col_pos) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_col(ImplicitInt col_pos) {
    return this->remove_cols(col_pos, 1);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_col(Pos col_pos) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_col(Pos col_pos) {
    return this->remove_col(col_pos.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_col([[maybe_unused]] Last lst) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_col([[maybe_unused]] Last lst) {
    return this->remove_col(this->cols() - 1_sl);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_front(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows_front(ImplicitInt count) {
    return this->remove_rows(0, count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_front(Count count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows_front(Count count) {
    return this->remove_rows_front(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_back(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows_back(ImplicitInt count) {
    return this->remove_rows(this->rows() - count.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_back(Count count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows_back(Count count) {
    return this->remove_rows_back(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_front(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols_front(ImplicitInt count) {
    return this->remove_cols(0, count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_front(Count count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols_front(Count count) {
    return this->remove_cols_front(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_back(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols_back(ImplicitInt count) {
    return this->remove_cols(this->cols() - count.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_back(Count count) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols_back(Count count) {
    return this->remove_cols_back(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(const std::vector<ImplicitInt>& indexes) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_rows(const std::vector<ImplicitInt>& indexes) {
+   ASSERT_STRICT_DEBUG(valid_complement_index_vector(
+       valid_row<RemoveCVRef<decltype(*this)>>, *this, indexes));
    if(!indexes.empty()) {
-      auto ci = complement_index_vector(
-          valid_row<RemoveCVRef<decltype(*this)>>, this->rows(), *this, indexes);
-
-      index_t new_rows = to_index_t(ci.size());
-      ArrayBase2D tmp(new_rows, new_rows == 0_sl ? 0_sl : this->cols());
-      for(index_t i = 0_sl; i < tmp.rows(); ++i) {
-         for(index_t j = 0_sl; j < tmp.cols(); ++j) {
-            tmp.un(i, j) = (*this).un(ci[to_size_t(i)], j);
-         }
+      if constexpr(L == RowMajor) {
+         this->remove_outer(indexes);
+      } else {
+         this->remove_inner(indexes);
       }
-      this->swap(tmp);
    }
 
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(const std::vector<ImplicitInt>& indexes) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::remove_cols(const std::vector<ImplicitInt>& indexes) {
+   ASSERT_STRICT_DEBUG(valid_complement_index_vector(
+       valid_col<RemoveCVRef<decltype(*this)>>, *this, indexes));
    if(!indexes.empty()) {
-      auto ci = complement_index_vector(
-          valid_col<RemoveCVRef<decltype(*this)>>, this->cols(), *this, indexes);
-
-      index_t new_cols = to_index_t(ci.size());
-      ArrayBase2D tmp(new_cols == 0_sl ? 0_sl : this->rows(), new_cols);
-      for(index_t i = 0_sl; i < tmp.rows(); ++i) {
-         for(index_t j = 0_sl; j < tmp.cols(); ++j) {
-            tmp.un(i, j) = (*this).un(i, ci[to_size_t(j)]);
-         }
+      if constexpr(L == RowMajor) {
+         this->remove_inner(indexes);
+      } else {
+         this->remove_outer(indexes);
       }
-      this->swap(tmp);
    }
 
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
@@ -473,8 +547,8 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(const std::vector<Implici
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows(ImplicitInt row_pos,
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_rows(ImplicitInt row_pos,
                                                        TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(row_pos.get() >= 0_sl && row_pos.get() <= this->rows());
    if(this->rows() == 0_sl && this->cols() == 0_sl) {
@@ -482,36 +556,46 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows(ImplicitInt row_pos,
    }
 
    ASSERT_STRICT_DEBUG(A.cols() == this->cols());
-   ArrayBase2D tmp(this->rows() + A.rows(), this->cols());
-
-   copy_rows(*this, tmp, row_pos.get());
-   copy_rows(A, tmp, 0_sl, row_pos.get(), A.rows());
-   copy_rows(*this, tmp, row_pos.get(), row_pos.get() + A.rows(), this->rows() - row_pos.get());
-   this->swap(tmp);
+   const index_t pos = row_pos.get();
+   const index_t count = A.rows();
+   // A may refer to this array. Rows appended to a row-major array are copied before the
+   // dimensions are updated, otherwise A is evaluated before rows are shifted.
+   if(L == RowMajor && pos == this->rows()) {
+      data1D_.resize(this->size() + count * this->cols());
+      copy_rows(A, *this, 0_sl, pos, count);
+      dims_.un(0) += count;
+   } else if(distinct_array(A, *this)) {
+      open_rows(pos, count);
+      copy_rows(A, *this, 0_sl, pos, count);
+   } else {
+      const ArrayBase2D B(A);
+      open_rows(pos, count);
+      copy_rows(B, *this, 0_sl, pos, count);
+   }
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows(Pos row_pos, TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_rows(Pos row_pos, TwoDimBaseType auto const& A) {
    return this->insert_rows(row_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows_front(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_rows_front(TwoDimBaseType auto const& A) {
    return this->insert_rows(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows_back(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_rows_back(TwoDimBaseType auto const& A) {
    return this->insert_rows(this->rows(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols(ImplicitInt col_pos,
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_cols(ImplicitInt col_pos,
                                                        TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(col_pos.get() >= 0_sl && col_pos.get() <= this->cols());
    if(this->rows() == 0_sl && this->cols() == 0_sl) {
@@ -519,36 +603,41 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols(ImplicitInt col_pos,
    }
 
    ASSERT_STRICT_DEBUG(A.rows() == this->rows());
-   ArrayBase2D tmp(this->rows(), this->cols() + A.cols());
-
-   copy_cols(*this, tmp, col_pos.get());
-   copy_cols(A, tmp, 0_sl, col_pos.get(), A.cols());
-   copy_cols(*this, tmp, col_pos.get(), col_pos.get() + A.cols(), this->cols() - col_pos.get());
-   this->swap(tmp);
+   const index_t pos = col_pos.get();
+   const index_t count = A.cols();
+   // A may refer to this array, in which case it is evaluated before columns are shifted.
+   if(distinct_array(A, *this)) {
+      open_cols(pos, count);
+      copy_cols(A, *this, 0_sl, pos, count);
+   } else {
+      const ArrayBase2D B(A);
+      open_cols(pos, count);
+      copy_cols(B, *this, 0_sl, pos, count);
+   }
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols(Pos col_pos, TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_cols(Pos col_pos, TwoDimBaseType auto const& A) {
    return this->insert_cols(col_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols_front(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_cols_front(TwoDimBaseType auto const& A) {
    return this->insert_cols(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols_back(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_cols_back(TwoDimBaseType auto const& A) {
    return this->insert_cols(this->cols(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(ImplicitInt row_pos,
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_row(ImplicitInt row_pos,
                                                       OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(row_pos.get() >= 0_sl && row_pos.get() <= this->rows());
    // Ensure A is not empty to satisfy semi_valid_row_col_sizes.
@@ -559,46 +648,40 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(ImplicitInt row_pos,
    }
 
    ASSERT_STRICT_DEBUG(A.size() == this->cols());
-   ArrayBase2D tmp(this->rows() + 1_sl, this->cols());
-
-   for(index_t i = 0_sl, count = 0_sl; i < tmp.rows(); ++i) {
-      if(i != row_pos.get()) {
-         for(index_t j = 0_sl; j < A.size(); ++j) {
-            tmp.un(i, j) = (*this).un(count, j);
-         }
-         ++count;
-      } else {
-         for(index_t j = 0_sl; j < A.size(); ++j) {
-            tmp.un(i, j) = A.un(j);
-         }
-      }
+   const index_t pos = row_pos.get();
+   // A may refer to this array, in which case it is evaluated before rows are shifted.
+   if(distinct_array(A, *this)) {
+      open_rows(pos, 1_sl);
+      this->assign_row(pos, A);
+   } else {
+      const ArrayBase1D<T, AF> B(A);
+      open_rows(pos, 1_sl);
+      this->assign_row(pos, B);
    }
-
-   this->swap(tmp);
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(Pos row_pos, OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_row(Pos row_pos, OneDimBaseType auto const& A) {
    return this->insert_row(row_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row_front(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_row_front(OneDimBaseType auto const& A) {
    return this->insert_row(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row_back(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_row_back(OneDimBaseType auto const& A) {
    return this->insert_row(this->rows(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(ImplicitInt col_pos,
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_col(ImplicitInt col_pos,
                                                       OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(col_pos.get() >= 0_sl && col_pos.get() <= this->cols());
    // Ensure A is not empty to satisfy semi_valid_row_col_sizes.
@@ -609,109 +692,351 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(ImplicitInt col_pos,
    }
 
    ASSERT_STRICT_DEBUG(A.size() == this->rows());
-   ArrayBase2D tmp(this->rows(), this->cols() + 1_sl);
-
-   for(index_t i = 0_sl; i < A.size(); ++i) {
-      for(index_t j = 0_sl, count = 0_sl; j < tmp.cols(); ++j) {
-         if(j != col_pos.get()) {
-            tmp.un(i, j) = (*this).un(i, count++);
-         } else {
-            tmp.un(i, j) = A.un(i);
-         }
-      }
+   const index_t pos = col_pos.get();
+   // A may refer to this array, in which case it is evaluated before columns are shifted.
+   if(distinct_array(A, *this)) {
+      open_cols(pos, 1_sl);
+      this->assign_col(pos, A);
+   } else {
+      const ArrayBase1D<T, AF> B(A);
+      open_cols(pos, 1_sl);
+      this->assign_col(pos, B);
    }
-
-   this->swap(tmp);
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(Pos col_pos, OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_col(Pos col_pos, OneDimBaseType auto const& A) {
    return this->insert_col(col_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col_front(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_col_front(OneDimBaseType auto const& A) {
    return this->insert_col(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col_back(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, L>::insert_col_back(OneDimBaseType auto const& A) {
    return this->insert_col(this->cols(), A);
 }
 
 
+// Shifts outer lines starting at pos by count lines towards the end. Lines pos, ...,
+// pos + count - 1 are left to be assigned by the caller.
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::open_outer(index_t pos, index_t count) {
+   const index_t n = this->inner();
+   const index_t size = this->size();
+   data1D_.resize(size + count * n);
+   auto* p = data1D_.data();
+   std::copy_backward(p + (pos * n).val(), p + size.val(), p + (size + count * n).val());
+   dims_.un(outer_dim) += count;
+}
+
+
+// Shifts elements of each outer line starting at pos by count elements towards the end.
+// Lines are moved starting from the last one, so no element is overwritten before it is
+// moved. Elements pos, ..., pos + count - 1 of each line are left to be assigned by the
+// caller.
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::open_inner(index_t pos, index_t count) {
+   const index_t n = this->inner();
+   const index_t n_new = n + count;
+   data1D_.resize(this->outer() * n_new);
+   auto* p = data1D_.data();
+   for(index_t i = this->outer() - 1_sl; i >= 0_sl; --i) {
+      auto* line = p + (i * n).val();
+      auto* line_new = p + (i * n_new).val();
+      std::copy_backward(line + pos.val(), line + n.val(), line_new + n_new.val());
+      if(i > 0_sl) {
+         std::copy_backward(line, line + pos.val(), line_new + pos.val());
+      }
+   }
+   dims_.un(inner_dim) = n_new;
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::open_rows(index_t pos, index_t count) {
+   if constexpr(L == RowMajor) {
+      this->open_outer(pos, count);
+   } else {
+      this->open_inner(pos, count);
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::open_cols(index_t pos, index_t count) {
+   if constexpr(L == RowMajor) {
+      this->open_inner(pos, count);
+   } else {
+      this->open_outer(pos, count);
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::remove_outer(index_t pos, index_t count) {
+   const index_t n = this->inner();
+   auto* p = data1D_.data();
+   std::copy(p + ((pos + count) * n).val(), p + this->size().val(), p + (pos * n).val());
+   this->set_outer_inner(this->outer() - count, n);
+}
+
+
+// Lines are moved to the front one after another, so no element is overwritten before it
+// is moved.
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::remove_inner(index_t pos, index_t count) {
+   const index_t n = this->inner();
+   const index_t n_new = n - count;
+   auto* p = data1D_.data();
+   for(index_t i = 0_sl; i < this->outer(); ++i) {
+      auto* line = p + (i * n).val();
+      auto* line_new = p + (i * n_new).val();
+      if(i > 0_sl) {
+         std::copy(line, line + pos.val(), line_new);
+      }
+      std::copy(line + (pos + count).val(), line + n.val(), line_new + pos.val());
+   }
+   this->set_outer_inner(this->outer(), n_new);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::remove_outer(const std::vector<ImplicitInt>& indexes) {
+   const index_t n = this->inner();
+   auto* p = data1D_.data();
+   const index_t outer_new
+       = for_each_complement_index(this->outer(), indexes, [p, n](index_t i, index_t k) {
+            if(i != k) {
+               std::copy(p + (i * n).val(), p + ((i + 1_sl) * n).val(), p + (k * n).val());
+            }
+         });
+   this->set_outer_inner(outer_new, n);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::remove_inner(const std::vector<ImplicitInt>& indexes) {
+   const index_t n = this->inner();
+   const index_t n_new = n - to_index_t(indexes.size());
+   auto* p = data1D_.data();
+   for(index_t i = 0_sl; i < this->outer(); ++i) {
+      for_each_complement_index(n, indexes, [p, i, n, n_new](index_t j, index_t k) {
+         p[(i * n_new + k).val()] = p[(i * n + j).val()];
+      });
+   }
+   this->set_outer_inner(this->outer(), n_new);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::assign_row(index_t i, OneDimBaseType auto const& A) {
+   if constexpr(L == RowMajor) {
+      copyn(A, data1D_, 0_sl, i * this->cols(), A.size());
+   } else {
+      for(index_t j = 0_sl; j < A.size(); ++j) {
+         this->un(i, j) = A.un(j);
+      }
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::assign_col(index_t j, OneDimBaseType auto const& A) {
+   if constexpr(L == ColMajor) {
+      copyn(A, data1D_, 0_sl, j * this->rows(), A.size());
+   } else {
+      for(index_t i = 0_sl; i < A.size(); ++i) {
+         this->un(i, j) = A.un(i);
+      }
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::set_outer_inner(index_t outer, index_t inner) {
+   if constexpr(L == RowMajor) {
+      this->set_dims(outer, inner);
+   } else {
+      this->set_dims(inner, outer);
+   }
+}
+
+
+// Removing all rows or all columns leaves an empty 0 x 0 array. Storage is kept for later
+// insertions.
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, L>::set_dims(index_t m, index_t n) {
+   if(m == 0_sl || n == 0_sl) {
+      m = 0_sl;
+      n = 0_sl;
+   }
+   data1D_.resize(m * n);
+   dims_.un(0) = m;
+   dims_.un(1) = n;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF>::rows() const {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, L>::rows() const {
    return dims_.un(0);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF>::cols() const {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, L>::cols() const {
    return dims_.un(1);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF>::size() const {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, L>::outer() const {
+   return dims_.un(outer_dim);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, L>::inner() const {
+   return dims_.un(inner_dim);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, L>::size() const {
    return data1D_.size();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i) -> value_type& {
-   return data1D_.un(i);
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* ArrayBase2D<T, AF, L>::resource() const {
+   return data1D_.resource();
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, L>::un(ImplicitInt i) -> value_type& {
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i);
+   } else {
+      auto [r, c] = index_map_one_to_two_dim(*this, i);
+      return this->un(r, c);
+   }
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i) const
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, L>::un(ImplicitInt i) const
     -> const value_type& {
-   return data1D_.un(i);
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i);
+   } else {
+      auto [r, c] = index_map_one_to_two_dim(*this, i);
+      return this->un(r, c);
+   }
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i, ImplicitInt j)
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, L>::un(ImplicitInt i, ImplicitInt j)
     -> value_type& {
-   return data1D_.un(i.get() * dims_.un(1) + j.get());
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i.get() * dims_.un(1) + j.get());
+   } else {
+      return data1D_.un(j.get() * dims_.un(0) + i.get());
+   }
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i, ImplicitInt j) const
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, L>::un(ImplicitInt i, ImplicitInt j) const
     -> const value_type& {
-   return data1D_.un(i.get() * dims_.un(1) + j.get());
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i.get() * dims_.un(1) + j.get());
+   } else {
+      return data1D_.un(j.get() * dims_.un(0) + i.get());
+   }
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_INLINE auto ArrayBase2D<T, AF, L>::load_packet(ImplicitInt i) const -> Packet<T>
+   requires(PacketBuiltin<T> && L == RowMajor)
+{
+   return data1D_.load_packet(i);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_INLINE void ArrayBase2D<T, AF, L>::store_packet(ImplicitInt i, Packet<T> x)
+   requires(PacketBuiltin<T> && L == RowMajor)
+{
+   data1D_.store_packet(i, x);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, L>::col_data(ImplicitInt j) & -> value_type*
+   requires(L == ColMajor)
+{
+   return data1D_.data() + (j.get() * dims_.un(0)).val();
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, L>::col_data(ImplicitInt j) const&
+    -> const value_type*
+   requires(L == ColMajor)
+{
+   return data1D_.data() + (j.get() * dims_.un(0)).val();
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, L>::storage() & -> ArrayBase1D<T, AF>&
+   requires(L == ColMajor)
+{
+   return data1D_;
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, L>::storage() const&
+    -> const ArrayBase1D<T, AF>&
+   requires(L == ColMajor)
+{
+   return data1D_;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF>::data() & -> value_type* {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, L>::data() & -> value_type* {
    return data1D_.data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF>::data() const& -> const value_type* {
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, L>::data() const& -> const value_type* {
    return data1D_.data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD auto ArrayBase2D<T, AF>::blas_data() & -> builtin_type*
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD auto ArrayBase2D<T, AF, L>::blas_data() & -> builtin_type*
    requires CompatibleBuiltin<T>
 {
    return data1D_.blas_data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD auto ArrayBase2D<T, AF>::blas_data() const& -> const builtin_type*
+template <Builtin T, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD auto ArrayBase2D<T, AF, L>::blas_data() const& -> const builtin_type*
    requires CompatibleBuiltin<T>
 {
    return data1D_.blas_data();
@@ -15,6 +15,7 @@
 
 #include "ArrayCommon/array_auxiliary.hpp"
 #include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/reduction.hpp"
 #include "Expr/expr.hpp"
 #include "StrictCommon/strict_common.hpp"
 
@@ -316,11 +317,7 @@ STRICT_CONSTEXPR ValueTypeOf<Base> sum(const Base& A, ValueTypeOf<Base> empty_de
    if(A.empty()) {
       return empty_default;
    }
-   ValueTypeOf<Base> s = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      s += A.un(i);
-   }
-   return s;
+   return detail::reduce(A, detail::ReduceSum{});
 }
 
 
@@ -329,11 +326,7 @@ STRICT_CONSTEXPR ValueTypeOf<Base> prod(const Base& A, ValueTypeOf<Base> empty_d
    if(A.empty()) {
       return empty_default;
    }
-   auto p = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      p *= A.un(i);
-   }
-   return p;
+   return detail::reduce(A, detail::ReduceProd{});
 }
 
 
@@ -351,11 +344,7 @@ STRICT_CONSTEXPR ValueTypeOf<Base> min(const Base& A, ValueTypeOf<Base> empty_de
    if(A.empty()) {
       return empty_default;
    }
-   auto min_elem = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      min_elem = mins(A.un(i), min_elem);
-   }
-   return min_elem;
+   return detail::reduce(A, detail::ReduceMin{});
 }
 
 
@@ -364,11 +353,7 @@ STRICT_CONSTEXPR ValueTypeOf<Base> max(const Base& A, ValueTypeOf<Base> empty_de
    if(A.empty()) {
       return empty_default;
    }
-   auto max_elem = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      max_elem = maxs(A.un(i), max_elem);
-   }
-   return max_elem;
+   return detail::reduce(A, detail::ReduceMax{});
 }
 
 
@@ -87,17 +87,16 @@ ValueTypeOf<Base1> stable_gpolynomial(const Base1& coeffs, const Base2& X, const
                                       ValueTypeOf<Base1> empty_default = {});
 
 
-template <FloatingBaseType Base>
-ValueTypeOf<Base> stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
-   if(A.empty()) {
-      return empty_default;
-   }
+namespace detail {
 
+
+// Adds the elements of A to the sum s with compensation c, so that sums of consecutive
+// parts of the elements are compensated as a whole.
+template <FloatingBaseType Base>
+void stable_sum_add(const Base& A, RealTypeOf<Base>& s, RealTypeOf<Base>& c) {
    using real_type = RealTypeOf<Base>;
    using value_type = ValueTypeOf<Base>;
 
-   real_type s{};
-   real_type c{};
    for(index_t i = 0_sl; i < A.size(); ++i) {
       auto xi = A.un(i);
       volatile real_type t = s + xi.val();
@@ -110,7 +109,22 @@ ValueTypeOf<Base> stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
       }
       s = t;
    }
-   return value_type{s + c};
+}
+
+
+}  // namespace detail
+
+
+template <FloatingBaseType Base>
+ValueTypeOf<Base> stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
+   if(A.empty()) {
+      return empty_default;
+   }
+
+   RealTypeOf<Base> s{};
+   RealTypeOf<Base> c{};
+   detail::stable_sum_add(A, s, c);
+   return ValueTypeOf<Base>{s + c};
 }
 
 
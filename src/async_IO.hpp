@@ -0,0 +1,269 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "array_IO.hpp"
+#include "binary_IO.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+#include "npy_IO.hpp"
+
+
+namespace spp {
+
+
+// Saving and loading in the background. Functions return immediately with a future that
+// becomes ready once the file has been written or read, and rethrows errors from get().
+// Arrays to be saved are copied before the functions return, or moved if passed as rvalues,
+// so that they can be modified right away. Formatting options of the text functions must
+// not be changed while they are pending.
+template <typename Base>
+   requires BaseType<RemoveCVRef<Base>>
+std::future<void> save_binary_async(const std::string& file_path, Base&& A);
+
+
+template <typename Base>
+   requires BaseType<RemoveCVRef<Base>>
+std::future<void> save_npy_async(const std::string& file_path, Base&& A);
+
+
+template <typename Base>
+   requires BaseType<RemoveCVRef<Base>>
+std::future<void> print_to_file_async(const std::string& file_path, Base&& A,
+                                      const std::string& name = "");
+
+
+template <typename Array>
+   requires requires(const std::string& s, Array& A) { load_binary(s, A); }
+std::future<Array> load_binary_async(const std::string& file_path);
+
+
+template <typename Array>
+   requires requires(const std::string& s, Array& A) { load_npy(s, A); }
+std::future<Array> load_npy_async(const std::string& file_path);
+
+
+template <typename Array>
+   requires requires(const std::string& s, Array& A) { read_from_file(s, A); }
+std::future<Array> read_from_file_async(const std::string& file_path);
+
+
+namespace detail {
+
+
+// Jobs are started in the order they are submitted. With a single thread, which is the
+// default, they also complete in that order, so e.g. a file that is saved and then loaded
+// is read after it has been written. Pending jobs are completed before the program exits.
+class IOThreadPool {
+public:
+   static IOThreadPool& instance() {
+      static IOThreadPool pool(1L);
+      return pool;
+   }
+
+   IOThreadPool(const IOThreadPool&) = delete;
+   IOThreadPool& operator=(const IOThreadPool&) = delete;
+
+   ~IOThreadPool() {
+      this->stop();
+   }
+
+   long int size() const {
+      return long(workers_.size());
+   }
+
+   // Waits for the pending jobs before the threads are replaced.
+   void resize(long int nthreads) {
+      std::lock_guard resize_lock{resize_mutex_};
+      this->stop();
+      this->start(nthreads);
+   }
+
+   template <typename F>
+   auto submit(F f) {
+      using R = std::invoke_result_t<F&>;
+      // std::function requires copyable jobs, packaged tasks are shared to satisfy it.
+      auto task = std::make_shared<std::packaged_task<R()>>(std::move(f));
+      auto future = task->get_future();
+      {
+         std::lock_guard lock{mutex_};
+         jobs_.emplace_back([task] { (*task)(); });
+      }
+      cv_.notify_one();
+      return future;
+   }
+
+private:
+   explicit IOThreadPool(long int nthreads) {
+      this->start(nthreads);
+   }
+
+   void start(long int nthreads) {
+      stop_ = false;
+      for(long int t = 0; t < nthreads; ++t) {
+         workers_.emplace_back([this] { this->loop(); });
+      }
+   }
+
+   void stop() {
+      {
+         std::lock_guard lock{mutex_};
+         stop_ = true;
+      }
+      cv_.notify_all();
+      for(auto& w : workers_) {
+         w.join();
+      }
+      workers_.clear();
+   }
+
+   // Exceptions are stored in the futures by the packaged tasks.
+   void loop() {
+      while(true) {
+         std::function<void()> job;
+         {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if(jobs_.empty()) {
+               return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+         }
+         job();
+      }
+   }
+
+   std::vector<std::thread> workers_;
+   std::deque<std::function<void()>> jobs_;
+   std::mutex resize_mutex_;
+   std::mutex mutex_;
+   std::condition_variable cv_;
+   bool stop_{};
+};
+
+
+// Arrays are copied or moved, other objects such as slices and expressions are evaluated
+// into arrays with the same layout. Snapshots are released by the I/O thread, possibly
+// after a memory resource of the calling thread has been destroyed, so they are allocated
+// with operator new. Arrays allocated from a memory resource are therefore copied even if
+// they are passed as rvalues.
+template <typename Base>
+auto io_snapshot(Base&& A) {
+   using B = RemoveCVRef<Base>;
+   using T = BuiltinTypeOf<B>;
+   const ScopedMemoryResource scope{nullptr};
+   if constexpr(ArrayType<B>) {
+      if constexpr(std::is_rvalue_reference_v<Base&&> && requires { A.resource(); }) {
+         if(A.resource() == nullptr) {
+            return B(std::move(A));
+         }
+      }
+      return B(std::as_const(A));
+   } else if constexpr(OneDimBaseType<B>) {
+      return Array1D<T, Aligned>(A);
+   } else {
+      return Array2D<T, Aligned, ColContiguousBaseType<B> ? ColMajor : RowMajor>(A);
+   }
+}
+
+
+// Snapshots are shared since jobs must be copyable, see IOThreadPool::submit.
+template <typename Base, typename F>
+std::future<void> save_async(Base&& A, F save) {
+   using Snapshot = decltype(io_snapshot(std::forward<Base>(A)));
+   auto snapshot = std::make_shared<Snapshot>(io_snapshot(std::forward<Base>(A)));
+   return IOThreadPool::instance().submit([snapshot, save] { save(*snapshot); });
+}
+
+
+template <typename Array, typename F>
+std::future<Array> load_async(F load) {
+   return IOThreadPool::instance().submit([load] {
+      Array A;
+      load(A);
+      return A;
+   });
+}
+
+
+}  // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename Base>
+   requires BaseType<RemoveCVRef<Base>>
+std::future<void> save_binary_async(const std::string& file_path, Base&& A) {
+   return detail::save_async(std::forward<Base>(A),
+                             [file_path](const auto& S) { save_binary(file_path, S); });
+}
+
+
+template <typename Base>
+   requires BaseType<RemoveCVRef<Base>>
+std::future<void> save_npy_async(const std::string& file_path, Base&& A) {
+   return detail::save_async(std::forward<Base>(A),
+                             [file_path](const auto& S) { save_npy(file_path, S); });
+}
+
+
+template <typename Base>
+   requires BaseType<RemoveCVRef<Base>>
+std::future<void> print_to_file_async(const std::string& file_path, Base&& A,
+                                      const std::string& name) {
+   return detail::save_async(std::forward<Base>(A), [file_path, name](const auto& S) {
+      print_to_file(file_path, S, name);
+   });
+}
+
+
+template <typename Array>
+   requires requires(const std::string& s, Array& A) { load_binary(s, A); }
+std::future<Array> load_binary_async(const std::string& file_path) {
+   return detail::load_async<Array>([file_path](Array& A) { load_binary(file_path, A); });
+}
+
+
+template <typename Array>
+   requires requires(const std::string& s, Array& A) { load_npy(s, A); }
+std::future<Array> load_npy_async(const std::string& file_path) {
+   return detail::load_async<Array>([file_path](Array& A) { load_npy(file_path, A); });
+}
+
+
+template <typename Array>
+   requires requires(const std::string& s, Array& A) { read_from_file(s, A); }
+std::future<Array> read_from_file_async(const std::string& file_path) {
+   return detail::load_async<Array>([file_path](Array& A) { read_from_file(file_path, A); });
+}
+
+
+// Number of threads that save and load files in the background.
+inline void set_io_threads(ImplicitInt nthreads) {
+   ASSERT_STRICT_ALWAYS(nthreads.get() > 0_sl);
+   detail::IOThreadPool::instance().resize(nthreads.get().val());
+}
+
+
+inline index_t io_threads() {
+   return index_t{detail::IOThreadPool::instance().size()};
+}
+
+
+}  // namespace spp
@@ -43,6 +43,14 @@ public:
       return data_[i.get().val()];
    }
 
+   STRICT_NODISCARD_INLINE value_type* data() {
+      return data_;
+   }
+
+   STRICT_NODISCARD_INLINE const value_type* data() const {
+      return data_;
+   }
+
    STRICT_NODISCARD_INLINE auto size() const {
       return n_;
    }
@@ -68,6 +76,10 @@ public:
       return data_[i.get().val()];
    }
 
+   STRICT_NODISCARD_INLINE const value_type* data() const {
+      return data_;
+   }
+
    STRICT_NODISCARD_INLINE auto size() const {
       return n_;
    }
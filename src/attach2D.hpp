@@ -21,11 +21,33 @@ template <TwoDimNonConstBaseType Base, typename Sl1, typename Sl2>
 class SliceArrayBase2D;
 
 
+template <Layout L>
+STRICT_INLINE long int attach_index(index_t i, index_t j, index_t m, index_t n) {
+   if constexpr(L == RowMajor) {
+      return i.val() * n.val() + j.val();
+   } else {
+      return j.val() * m.val() + i.val();
+   }
+}
+
+
+template <Layout L>
+STRICT_INLINE long int attach_index(index_t i, index_t m, index_t n) {
+   if constexpr(L == RowMajor) {
+      return i.val();
+   } else {
+      return attach_index<L>(i / n, i % n, m, n);
+   }
+}
+
+
 template <TwoDimBaseType Base, typename Sl1, typename Sl2>
 class ConstSliceArrayBase2D;
 
 
-template <Builtin T>
+// Elements are stored in the order given by L. Linear indexes refer to row-major order
+// regardless of L, as for arrays.
+template <Builtin T, Layout L = RowMajor>
 struct STRICT_NODISCARD strict_attach_ptr2D : private CopyBase2D {
 public:
    using value_type = Strict<T>;
@@ -38,19 +60,27 @@ public:
    }
 
    STRICT_NODISCARD_INLINE value_type& un(ImplicitInt i) {
-      return data_[i.get().val()];
+      return data_[attach_index<L>(i.get(), m_, n_)];
    }
 
    STRICT_NODISCARD_INLINE const value_type& un(ImplicitInt i) const {
-      return data_[i.get().val()];
+      return data_[attach_index<L>(i.get(), m_, n_)];
    }
 
    STRICT_NODISCARD_INLINE value_type& un(ImplicitInt i, ImplicitInt j) {
-      return data_[i.get().val() * n_.val() + j.get().val()];
+      return data_[attach_index<L>(i.get(), j.get(), m_, n_)];
    }
 
    STRICT_NODISCARD_INLINE const value_type& un(ImplicitInt i, ImplicitInt j) const {
-      return data_[i.get().val() * n_.val() + j.get().val()];
+      return data_[attach_index<L>(i.get(), j.get(), m_, n_)];
+   }
+
+   STRICT_NODISCARD_INLINE value_type* data() {
+      return data_;
+   }
+
+   STRICT_NODISCARD_INLINE const value_type* data() const {
+      return data_;
    }
 
    STRICT_NODISCARD_INLINE auto rows() const {
@@ -71,7 +101,7 @@ private:
 };
 
 
-template <Builtin T>
+template <Builtin T, Layout L = RowMajor>
 struct STRICT_NODISCARD const_strict_attach_ptr2D : private CopyBase2D {
 public:
    using value_type = Strict<T>;
@@ -84,11 +114,15 @@ public:
    }
 
    STRICT_NODISCARD_INLINE const value_type& un(ImplicitInt i) const {
-      return data_[i.get().val()];
+      return data_[attach_index<L>(i.get(), m_, n_)];
    }
 
    STRICT_NODISCARD_INLINE const value_type& un(ImplicitInt i, ImplicitInt j) const {
-      return data_[i.get().val() * n_.val() + j.get().val()];
+      return data_[attach_index<L>(i.get(), j.get(), m_, n_)];
+   }
+
+   STRICT_NODISCARD_INLINE const value_type* data() const {
+      return data_;
    }
 
    STRICT_NODISCARD_INLINE auto rows() const {
@@ -287,19 +321,21 @@ STRICT_CONSTEXPR auto StrictArrayBase2D<Base>::view2D(ImplicitInt nrows, Implici
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template <detail::PointerConvertibleLvalue T>
+// m x n elements stored in the order given by L, e.g. attach2D<ColMajor>(data, m, n) for
+// column-major data.
+template <Layout L = RowMajor, detail::PointerConvertibleLvalue T>
 auto attach2D(T&& data, ImplicitInt m, ImplicitInt n) {
    using namespace detail;
-   auto proxy = strict_attach_ptr2D(data, m, n);
+   auto proxy = strict_attach_ptr2D<RemoveCVRef<decltype(data[0])>, L>(data, m, n);
    return StrictArrayMutable2D<SliceArrayBase2D<decltype(proxy), seqN, seqN>>{
        proxy, seqN{0, m}, seqN{0, n}};
 }
 
 
-template <detail::PointerConvertibleLvalueConst T>
+template <Layout L = RowMajor, detail::PointerConvertibleLvalueConst T>
 auto attach2D(T&& data, ImplicitInt m, ImplicitInt n) {
    using namespace detail;
-   auto proxy = const_strict_attach_ptr2D(data, m, n);
+   auto proxy = const_strict_attach_ptr2D<RemoveCVRef<decltype(data[0])>, L>(data, m, n);
    return StrictArrayBase2D<ConstSliceArrayBase2D<decltype(proxy), seqN, seqN>>{
        proxy, seqN{0, m}, seqN{0, n}};
 }
@@ -0,0 +1,413 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+#include "mapped_file.hpp"
+
+
+namespace spp {
+
+
+// Binary files consist of a 64-byte header followed by the elements. Elements of
+// two-dimensional objects are stored in the order given by the header, which is the storage
+// order of column-major arrays and row-major order otherwise. Files written on machines with
+// different byte order are converted when loaded.
+void save_binary(const std::string& file_path, BaseType auto const& A);
+
+
+template <Builtin T, AlignmentFlag AF>
+void load_binary(const std::string& file_path, Array1D<T, AF>& A);
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+void load_binary(const std::string& file_path, Array2D<T, AF, L>& A);
+
+
+// Fixed arrays and slices are not resized, the file must have the same dimensions.
+template <typename Base>
+   requires(detail::NonConstBaseType<RemoveCVRef<Base>>
+            && !detail::has_resize<RemoveCVRef<Base>>::value)
+void load_binary(const std::string& file_path, Base&& A);
+
+
+struct BinaryHeader {
+   static constexpr std::size_t size = 64;
+   static constexpr std::uint8_t current_version = 1;
+
+   char magic[6];
+   std::uint8_t version;
+   std::uint8_t little_endian;
+   std::uint8_t type;
+   std::uint8_t type_size;
+   std::uint8_t rank;
+   std::uint8_t layout;
+   std::uint32_t alignment;
+   std::int64_t dims[2];
+   std::uint64_t data_offset;
+   char reserved[24];
+};
+
+
+static_assert(sizeof(BinaryHeader) == BinaryHeader::size);
+
+
+namespace detail {
+
+
+inline constexpr char binary_magic[6] = {'S', 'P', 'P', 'B', 'I', 'N'};
+
+
+// Elements are read and written in chunks of this many bytes if they are not stored
+// contiguously.
+inline constexpr std::size_t binary_chunk_bytes = std::size_t(1) << 20;
+
+
+template <Builtin T>
+constexpr std::uint8_t binary_type_code() {
+   if constexpr(Boolean<T>) {
+      return 1;
+   } else if constexpr(SameAs<T, int>) {
+      return 2;
+   } else if constexpr(SameAs<T, long int>) {
+      return 3;
+   } else if constexpr(SameAs<T, unsigned int>) {
+      return 4;
+   } else if constexpr(SameAs<T, unsigned long int>) {
+      return 5;
+   } else if constexpr(SameAs<T, float>) {
+      return 6;
+   } else if constexpr(SameAs<T, double>) {
+      return 7;
+   } else if constexpr(SameAs<T, long double>) {
+      return 8;
+   } else {
+      return 9;
+   }
+}
+
+
+inline constexpr bool native_little_endian = std::endian::native == std::endian::little;
+
+
+template <Builtin T>
+BinaryHeader make_binary_header(index_t m, index_t n, long int rank, Layout layout) {
+   BinaryHeader h{};
+   std::memcpy(h.magic, binary_magic, sizeof(h.magic));
+   h.version = BinaryHeader::current_version;
+   h.little_endian = native_little_endian;
+   h.type = binary_type_code<T>();
+   h.type_size = sizeof(T);
+   h.rank = std::uint8_t(rank);
+   h.layout = std::uint8_t(layout);
+   h.alignment = BinaryHeader::size;
+   h.dims[0] = m.val();
+   h.dims[1] = n.val();
+   h.data_offset = BinaryHeader::size;
+   return h;
+}
+
+
+// Header fields are stored in the byte order of the machine that wrote the file.
+inline void byteswap_bytes(void* p, std::size_t size, std::size_t count) {
+   auto* b = static_cast<unsigned char*>(p);
+   for(std::size_t k = 0; k < count; ++k, b += size) {
+      std::reverse(b, b + size);
+   }
+}
+
+
+inline void byteswap_header(BinaryHeader& h) {
+   byteswap_bytes(&h.alignment, sizeof(h.alignment), 1);
+   byteswap_bytes(h.dims, sizeof(h.dims[0]), 2);
+   byteswap_bytes(&h.data_offset, sizeof(h.data_offset), 1);
+}
+
+
+template <Builtin T>
+void validate_binary_header(const BinaryHeader& h, long int rank) {
+   ASSERT_STRICT_ALWAYS_MSG(std::memcmp(h.magic, binary_magic, sizeof(h.magic)) == 0,
+                            "Invalid binary file.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.version == BinaryHeader::current_version,
+                            "Unsupported binary file version.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.type == binary_type_code<T>() && h.type_size == sizeof(T),
+                            "Type of the binary file does not match.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.rank == rank, "Dimension of the binary file does not match.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.dims[0] >= 0 && h.dims[1] >= 0, "Invalid binary file.\n");
+}
+
+
+struct FileCloser {
+   void operator()(std::FILE* f) const {
+      std::fclose(f);
+   }
+};
+
+
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+
+// Streams are unbuffered, so that contiguous elements are transferred by a single system
+// call instead of being copied through the buffer of the stream.
+inline FilePtr open_binary(const std::string& file_path, const char* mode) {
+   FilePtr f{std::fopen(file_path.c_str(), mode)};
+   ASSERT_STRICT_ALWAYS_MSG(f != nullptr, "Invalid file path.\n");
+   std::setvbuf(f.get(), nullptr, _IONBF, 0);
+   return f;
+}
+
+
+inline void write_bytes(std::FILE* f, const void* p, std::size_t bytes) {
+   ASSERT_STRICT_ALWAYS_MSG(std::fwrite(p, 1, bytes, f) == bytes, "Cannot write to the file.\n");
+}
+
+
+inline void read_bytes(std::FILE* f, void* p, std::size_t bytes) {
+   ASSERT_STRICT_ALWAYS_MSG(std::fread(p, 1, bytes, f) == bytes, "Unexpected end of the file.\n");
+}
+
+
+// Number of bytes from the current position to the end of the file.
+inline std::size_t remaining_bytes(std::FILE* f) {
+   const long int pos = std::ftell(f);
+   ASSERT_STRICT_ALWAYS(pos >= 0 && std::fseek(f, 0, SEEK_END) == 0);
+   const long int end = std::ftell(f);
+   ASSERT_STRICT_ALWAYS(end >= 0 && std::fseek(f, pos, SEEK_SET) == 0);
+   return end > pos ? std::size_t(end - pos) : 0;
+}
+
+
+// Checks that m x n elements follow the current position before they are allocated, so that
+// dimensions of a corrupt or truncated file cannot cause a huge allocation.
+template <Builtin T>
+void check_remaining_elements(std::FILE* f, index_t m, index_t n) {
+   ASSERT_STRICT_ALWAYS_MSG(fits_in_bytes(m, n, sizeof(T), remaining_bytes(f)),
+                            "Unexpected end of the file.\n");
+}
+
+
+inline BinaryHeader read_binary_header(std::FILE* f) {
+   BinaryHeader h;
+   read_bytes(f, &h, sizeof(h));
+   if(bool(h.little_endian) != native_little_endian) {
+      byteswap_header(h);
+   }
+   ASSERT_STRICT_ALWAYS_MSG(h.data_offset >= sizeof(h), "Invalid binary file.\n");
+   ASSERT_STRICT_ALWAYS(std::fseek(f, long(h.data_offset), SEEK_SET) == 0);
+   return h;
+}
+
+
+// Linear index k of the elements in the file refers to row k % m and column k / m of
+// column-major files.
+template <BaseType Base>
+STRICT_INLINE decltype(auto) binary_element(Base& A, index_t k, bool col_major) {
+   if constexpr(TwoDimBaseType<RemoveCVRef<Base>>) {
+      if(col_major) {
+         return A.un(k % A.rows(), k / A.rows());
+      }
+   }
+   return A.un(k);
+}
+
+
+// Returns pointer to the elements of A if they are stored contiguously in the given order,
+// nullptr otherwise.
+template <BaseType Base>
+STRICT_INLINE auto binary_data(Base& A, bool col_major) {
+   if constexpr(ColContiguousBaseType<RemoveCVRef<Base>>) {
+      return col_major && A.size() != 0_sl ? A.col_data(0) : decltype(A.col_data(0)){nullptr};
+   } else {
+      auto p = contiguous_data(A);
+      return col_major ? decltype(p){nullptr} : p;
+   }
+}
+
+
+template <BaseType Base>
+void write_binary_elements(std::FILE* f, const Base& A, bool col_major) {
+   using T = BuiltinTypeOf<Base>;
+   if constexpr(CompatibleBuiltin<T>) {
+      if(const auto* p = binary_data(A, col_major); p != nullptr) {
+         write_bytes(f, p, std::size_t(A.size().val()) * sizeof(T));
+         return;
+      }
+   }
+
+   const index_t chunk = to_index_t(std::max(binary_chunk_bytes / sizeof(T), std::size_t(1)));
+   auto buffer = std::make_unique<T[]>(std::size_t(mins(chunk, A.size()).val()));
+   for(index_t first = 0_sl; first < A.size(); first += chunk) {
+      const index_t count = mins(chunk, A.size() - first);
+      for(index_t k = 0_sl; k < count; ++k) {
+         buffer[std::size_t(k.val())] = binary_element(A, first + k, col_major).val();
+      }
+      write_bytes(f, buffer.get(), std::size_t(count.val()) * sizeof(T));
+   }
+}
+
+
+template <BaseType Base>
+void read_binary_elements(std::FILE* f, Base& A, const BinaryHeader& h) {
+   using T = BuiltinTypeOf<Base>;
+   const bool col_major = h.rank == 2 && h.layout == ColMajor;
+   const bool swap = bool(h.little_endian) != native_little_endian;
+   if constexpr(CompatibleBuiltin<T>) {
+      if(auto* p = binary_data(A, col_major); p != nullptr) {
+         read_bytes(f, p, std::size_t(A.size().val()) * sizeof(T));
+         if(swap) {
+            byteswap_bytes(p, sizeof(T), std::size_t(A.size().val()));
+         }
+         return;
+      }
+   }
+
+   const index_t chunk = to_index_t(std::max(binary_chunk_bytes / sizeof(T), std::size_t(1)));
+   auto buffer = std::make_unique<T[]>(std::size_t(mins(chunk, A.size()).val()));
+   for(index_t first = 0_sl; first < A.size(); first += chunk) {
+      const index_t count = mins(chunk, A.size() - first);
+      read_bytes(f, buffer.get(), std::size_t(count.val()) * sizeof(T));
+      if(swap) {
+         byteswap_bytes(buffer.get(), sizeof(T), std::size_t(count.val()));
+      }
+      for(index_t k = 0_sl; k < count; ++k) {
+         binary_element(A, first + k, col_major) = Strict<T>{buffer[std::size_t(k.val())]};
+      }
+   }
+}
+
+
+}  // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void save_binary(const std::string& file_path, BaseType auto const& A) {
+   using Base = RemoveCVRef<decltype(A)>;
+   using T = BuiltinTypeOf<Base>;
+   BinaryHeader h;
+   if constexpr(OneDimBaseType<Base>) {
+      h = detail::make_binary_header<T>(A.size(), 1_sl, 1L, RowMajor);
+   } else {
+      const Layout L = detail::ColContiguousBaseType<Base> ? ColMajor : RowMajor;
+      h = detail::make_binary_header<T>(A.rows(), A.cols(), 2L, L);
+   }
+
+   auto f = detail::open_binary(file_path, "wb");
+   detail::write_bytes(f.get(), &h, sizeof(h));
+   detail::write_binary_elements(f.get(), A, h.layout == ColMajor && h.rank == 2);
+   ASSERT_STRICT_ALWAYS_MSG(std::fclose(f.release()) == 0, "Cannot write to the file.\n");
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+void load_binary(const std::string& file_path, Array1D<T, AF>& A) {
+   auto f = detail::open_binary(file_path, "rb");
+   const BinaryHeader h = detail::read_binary_header(f.get());
+   detail::validate_binary_header<T>(h, 1L);
+   detail::check_remaining_elements<T>(f.get(), 1_sl, index_t{h.dims[0]});
+
+   Array1D<T, AF> tmp(h.dims[0], uninitialized);
+   detail::read_binary_elements(f.get(), tmp, h);
+   A.swap(tmp);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+void load_binary(const std::string& file_path, Array2D<T, AF, L>& A) {
+   auto f = detail::open_binary(file_path, "rb");
+   const BinaryHeader h = detail::read_binary_header(f.get());
+   detail::validate_binary_header<T>(h, 2L);
+   detail::check_remaining_elements<T>(f.get(), index_t{h.dims[0]}, index_t{h.dims[1]});
+
+   Array2D<T, AF, L> tmp(h.dims[0], h.dims[1], uninitialized);
+   detail::read_binary_elements(f.get(), tmp, h);
+   A.swap(tmp);
+}
+
+
+template <typename Base>
+   requires(detail::NonConstBaseType<RemoveCVRef<Base>>
+            && !detail::has_resize<RemoveCVRef<Base>>::value)
+void load_binary(const std::string& file_path, Base&& A) {
+   using T = BuiltinTypeOf<RemoveCVRef<Base>>;
+   auto f = detail::open_binary(file_path, "rb");
+   const BinaryHeader h = detail::read_binary_header(f.get());
+   if constexpr(OneDimBaseType<RemoveCVRef<Base>>) {
+      detail::validate_binary_header<T>(h, 1L);
+      ASSERT_STRICT_ALWAYS_MSG(h.dims[0] == A.size().val(), "Dimensions do not match.\n");
+   } else {
+      detail::validate_binary_header<T>(h, 2L);
+      ASSERT_STRICT_ALWAYS_MSG(h.dims[0] == A.rows().val() && h.dims[1] == A.cols().val(),
+                               "Dimensions do not match.\n");
+   }
+   detail::read_binary_elements(f.get(), A, h);
+}
+
+
+#ifdef __linux__
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+
+template <Builtin T>
+BinaryHeader mapped_binary_header(const MappedFile& file, long int rank) {
+   ASSERT_STRICT_ALWAYS_MSG(file.size() >= sizeof(BinaryHeader), "Invalid binary file.\n");
+   BinaryHeader h;
+   std::memcpy(&h, file.data<char>(), sizeof(h));
+   ASSERT_STRICT_ALWAYS_MSG(bool(h.little_endian) == native_little_endian,
+                            "Binary file with different byte order cannot be mapped.\n");
+   validate_binary_header<T>(h, rank);
+   ASSERT_STRICT_ALWAYS_MSG(rank == 1 || h.layout == RowMajor,
+                            "Column-major binary file cannot be mapped.\n");
+   return h;
+}
+
+
+}  // namespace detail
+
+
+// Elements of binary files are attached without reading them, see MappedFile. Files must be
+// written on a machine with the same byte order, two-dimensional ones in row-major order.
+template <detail::CompatibleBuiltin T>
+auto attach_binary1D(MappedFile& file) {
+   const BinaryHeader h = detail::mapped_binary_header<T>(file, 1L);
+   return attach1D<T>(file, h.dims[0], h.data_offset);
+}
+
+
+template <detail::CompatibleBuiltin T>
+auto attach_binary1D(const MappedFile& file) {
+   const BinaryHeader h = detail::mapped_binary_header<T>(file, 1L);
+   return attach1D<T>(file, h.dims[0], h.data_offset);
+}
+
+
+template <detail::CompatibleBuiltin T>
+auto attach_binary2D(MappedFile& file) {
+   const BinaryHeader h = detail::mapped_binary_header<T>(file, 2L);
+   return attach2D<T>(file, h.dims[0], h.dims[1], h.data_offset);
+}
+
+
+template <detail::CompatibleBuiltin T>
+auto attach_binary2D(const MappedFile& file) {
+   const BinaryHeader h = detail::mapped_binary_header<T>(file, 2L);
+   return attach2D<T>(file, h.dims[0], h.dims[1], h.data_offset);
+}
+#endif
+
+
+}  // namespace spp
@@ -14,6 +14,7 @@
 #include "derived1D.hpp"
 #include "fixed_array_base2D.hpp"
 #include "iterator.hpp"
+#include "padded_array_base2D.hpp"
 #include "slice.hpp"
 #include "slicearray_base2D.hpp"
 
@@ -29,12 +30,17 @@ template <typename Base>
 class StrictArray2D;
 
 
-template <Builtin T, AlignmentFlag AF = Unaligned>
-using Array2D = StrictArray2D<detail::ArrayBase2D<T, AF>>;
+template <Builtin T, AlignmentFlag AF = Unaligned, Layout L = RowMajor>
+using Array2D = StrictArray2D<detail::ArrayBase2D<T, AF, L>>;
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF = Unaligned>
-using FixedArray2D = StrictArray2D<detail::FixedArrayBase2D<T, M, N, AF>>;
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF = Unaligned,
+          Layout L = RowMajor>
+using FixedArray2D = StrictArray2D<detail::FixedArrayBase2D<T, M, N, AF, L>>;
+
+
+template <Builtin T>
+using PaddedArray2D = StrictArray2D<detail::PaddedArrayBase2D<T>>;
 
 
 template <TwoDimBaseType Base>
@@ -216,8 +222,9 @@ public:
       using namespace detail;
       auto ih = index_row_helper(*this, i);
       ASSERT_STRICT_DEBUG(valid_row(*this, ih));
-      auto first = ih * Base::cols();
-      return this->view1D()(seq{first, first + Base::cols() - 1_sl, 1});
+      auto first = ih * this->row_stride();
+      auto lst = first + (Base::cols() - 1_sl) * this->col_stride();
+      return this->storage1D()(seq{first, lst, this->col_stride()});
    }
 
    template <IndexType Index>
@@ -225,17 +232,18 @@ public:
       using namespace detail;
       auto jh = index_col_helper(*this, j);
       ASSERT_STRICT_DEBUG(valid_col(*this, jh));
-      auto first = jh;
-      auto lst = first + (Base::rows() - 1_sl) * Base::cols();
-      return this->view1D()(seq{first, lst, Base::cols()});
+      auto first = jh * this->col_stride();
+      auto lst = first + (Base::rows() - 1_sl) * this->row_stride();
+      return this->storage1D()(seq{first, lst, this->row_stride()});
    }
 
    STRICT_CONSTEXPR auto diag() & {
-      return this->view1D()(seqN{0, mins(Base::rows(), Base::cols()), Base::cols() + 1_sl});
+      return this->storage1D()(
+          seqN{0, mins(Base::rows(), Base::cols()), this->row_stride() + this->col_stride()});
    }
 
    STRICT_CONSTEXPR auto diag(ImplicitInt i) & {
-      return this->view1D()(this->diag_slice_impl(i));
+      return this->storage1D()(this->diag_slice_impl(i));
    }
 
    STRICT_CONSTEXPR auto view1D() & {
@@ -258,8 +266,9 @@ public:
       using namespace detail;
       auto ih = index_row_helper(*this, i);
       ASSERT_STRICT_DEBUG(valid_row(*this, ih));
-      auto first = ih * Base::cols();
-      return this->view1D()(seq{first, first + Base::cols() - 1_sl, 1});
+      auto first = ih * this->row_stride();
+      auto lst = first + (Base::cols() - 1_sl) * this->col_stride();
+      return this->storage1D()(seq{first, lst, this->col_stride()});
    }
 
    template <IndexType Index>
@@ -267,17 +276,18 @@ public:
       using namespace detail;
       auto jh = index_col_helper(*this, j);
       ASSERT_STRICT_DEBUG(valid_col(*this, jh));
-      auto first = jh;
-      auto lst = first + (Base::rows() - 1_sl) * Base::cols();
-      return this->view1D()(seq{first, lst, Base::cols()});
+      auto first = jh * this->col_stride();
+      auto lst = first + (Base::rows() - 1_sl) * this->row_stride();
+      return this->storage1D()(seq{first, lst, this->row_stride()});
    }
 
    STRICT_CONSTEXPR auto diag() const& {
-      return this->view1D()(seqN{0, mins(Base::rows(), Base::cols()), Base::cols() + 1_sl});
+      return this->storage1D()(
+          seqN{0, mins(Base::rows(), Base::cols()), this->row_stride() + this->col_stride()});
    }
 
    STRICT_CONSTEXPR auto diag(ImplicitInt i) const& {
-      return this->view1D()(this->diag_slice_impl(i));
+      return this->storage1D()(this->diag_slice_impl(i));
    }
 
    STRICT_CONSTEXPR auto view1D() const& {
@@ -631,12 +641,67 @@ private:
    STRICT_CONSTEXPR auto diag_slice_impl(ImplicitInt i) const {
       if(i.get() >= 0_sl) {
          ASSERT_STRICT_DEBUG(i.get() < Base::cols());
-         return seqN{i, mins(Base::rows(), Base::cols() - i.get()), Base::cols() + 1_sl};
+         return seqN{i.get() * this->col_stride(), mins(Base::rows(), Base::cols() - i.get()),
+                     this->row_stride() + this->col_stride()};
       } else {
          ASSERT_STRICT_DEBUG(abss(i.get()) < Base::rows());
-         return seqN{abss(i.get()) * Base::cols(),
+         return seqN{abss(i.get()) * this->row_stride(),
                      mins(Base::rows() - abss(i.get()), Base::cols()),
-                     Base::cols() + 1_sl};
+                     this->row_stride() + this->col_stride()};
+      }
+   }
+
+   // Distance between elements in consecutive rows of the same column in storage1D().
+   STRICT_CONSTEXPR index_t row_stride() const {
+      if constexpr(detail::RowContiguousBaseType<Base>) {
+         return Base::leading_dim();
+      } else if constexpr(detail::ColContiguousBaseType<Base>) {
+         return 1_sl;
+      } else {
+         return Base::cols();
+      }
+   }
+
+   // Distance between elements in consecutive columns of the same row in storage1D().
+   STRICT_CONSTEXPR index_t col_stride() const {
+      if constexpr(detail::ColContiguousBaseType<Base>) {
+         return Base::rows();
+      } else {
+         return 1_sl;
+      }
+   }
+
+   // Arrays with padded rows or column-major arrays are sliced from their storage, so that
+   // rows, columns and diagonals are read directly rather than by mapping each index to a row
+   // and column.
+   STRICT_CONSTEXPR decltype(auto) storage1D() & {
+      using namespace detail;
+      if constexpr(RowContiguousBaseType<Base>) {
+         return Base::storage();
+      } else if constexpr(ColContiguousBaseType<Base>) {
+         using Storage = RemoveRef<decltype(Base::storage())>;
+         if constexpr(NonConstBaseType<Base>) {
+            return StrictArrayMutable1D<SliceArrayBase1D<Storage, seqN>>{
+                Base::storage(), seqN{0, Base::size(), 1}};
+         } else {
+            return StrictArrayBase1D<ConstSliceArrayBase1D<Storage, seqN>>{
+                Base::storage(), seqN{0, Base::size(), 1}};
+         }
+      } else {
+         return this->view1D();
+      }
+   }
+
+   STRICT_CONSTEXPR decltype(auto) storage1D() const& {
+      using namespace detail;
+      if constexpr(RowContiguousBaseType<Base>) {
+         return Base::storage();
+      } else if constexpr(ColContiguousBaseType<Base>) {
+         using Storage = RemoveCVRef<decltype(Base::storage())>;
+         return StrictArrayBase1D<ConstSliceArrayBase1D<Storage, seqN>>{
+             Base::storage(), seqN{0, Base::size(), 1}};
+      } else {
+         return this->view1D();
       }
    }
 };
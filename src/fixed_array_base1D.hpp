@@ -19,6 +19,10 @@ public:
    using value_type = Strict<T>;
    using builtin_type = T;
 
+   // data() is aligned to alignment bytes, see STRICT_ALIGNMENT.
+   static constexpr std::size_t alignment
+       = std::size_t(detail::fixed_alignment_of<T, N.get().val(), AF>());
+
    static_assert(N.get() > -1_sl);
 
    // Constructors.
@@ -48,6 +52,11 @@ public:
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i) const;
 
+   STRICT_NODISCARD_INLINE Packet<T> load_packet(ImplicitInt i) const
+      requires PacketBuiltin<T>;
+   STRICT_INLINE void store_packet(ImplicitInt i, Packet<T> x)
+      requires PacketBuiltin<T>;
+
    STRICT_NODISCARD_CONSTEXPR value_type* data() &;
    STRICT_NODISCARD_CONSTEXPR const value_type* data() const&;
    STRICT_NODISCARD_CONSTEXPR value_type* data() && = delete;
@@ -72,7 +81,7 @@ private:
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wattributes"
 #endif
-   alignas(detail::alignment_of<T, AF>()) value_type data_[to_size_t(N.get())];
+   alignas(alignment) value_type data_[to_size_t(N.get())];
 #ifdef __GNUG__
 #pragma GCC diagnostic pop
 #endif
@@ -197,6 +206,23 @@ STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase1D<T, N, AF>::un(ImplicitIn
 }
 
 
+template <Builtin T, ImplicitIntStatic N, AlignmentFlag AF>
+STRICT_NODISCARD_INLINE auto FixedArrayBase1D<T, N, AF>::load_packet(ImplicitInt i) const
+    -> Packet<T>
+   requires PacketBuiltin<T>
+{
+   return detail::load_packet<AF>(data_ + i.get().val());
+}
+
+
+template <Builtin T, ImplicitIntStatic N, AlignmentFlag AF>
+STRICT_INLINE void FixedArrayBase1D<T, N, AF>::store_packet(ImplicitInt i, Packet<T> x)
+   requires PacketBuiltin<T>
+{
+   detail::store_packet<AF>(data_ + i.get().val(), x);
+}
+
+
 template <Builtin T, ImplicitIntStatic N, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase1D<T, N, AF>::data() & -> value_type* {
    return this->size() != 0_sl ? data_ : nullptr;
@@ -13,12 +13,16 @@ namespace spp::detail {
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
+// Elements are stored in the order of L, see ArrayBase2D.
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF,
+          Layout L = RowMajor>
 class STRICT_NODISCARD FixedArrayBase2D : private ReferenceBase2D, private TwoDimArrayBase {
 public:
    using value_type = Strict<T>;
    using builtin_type = T;
 
+   static constexpr std::size_t alignment = FixedArrayBase1D<T, M.get() * N.get(), AF>::alignment;
+
    // Important to test these, otherwise expressions like FixedArray2D<int, -2, -2>
    // would erroneously compile(-2 * -2 = 4, which is nonnegative).
    static_assert(M.get() > -1_sl);
@@ -55,6 +59,23 @@ public:
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i, ImplicitInt j);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i, ImplicitInt j) const;
 
+   STRICT_NODISCARD_INLINE Packet<T> load_packet(ImplicitInt i) const
+      requires(PacketBuiltin<T> && L == RowMajor);
+   STRICT_INLINE void store_packet(ImplicitInt i, Packet<T> x)
+      requires(PacketBuiltin<T> && L == RowMajor);
+
+   STRICT_NODISCARD_CONSTEXPR value_type* col_data(ImplicitInt j) &
+      requires(L == ColMajor);
+   STRICT_NODISCARD_CONSTEXPR const value_type* col_data(ImplicitInt j) const&
+      requires(L == ColMajor);
+   STRICT_NODISCARD_CONSTEXPR value_type* col_data(ImplicitInt j) && = delete;
+   STRICT_NODISCARD_CONSTEXPR const value_type* col_data(ImplicitInt j) const&& = delete;
+
+   STRICT_NODISCARD_CONSTEXPR FixedArrayBase1D<T, M.get() * N.get(), AF>& storage() &
+      requires(L == ColMajor);
+   STRICT_NODISCARD_CONSTEXPR const FixedArrayBase1D<T, M.get() * N.get(), AF>& storage() const&
+      requires(L == ColMajor);
+
    STRICT_NODISCARD_CONSTEXPR value_type* data() &;
    STRICT_NODISCARD_CONSTEXPR const value_type* data() const&;
    STRICT_NODISCARD_CONSTEXPR value_type* data() && = delete;
@@ -79,20 +100,20 @@ private:
 };
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF>::FixedArrayBase2D(value_type x) {
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>::FixedArrayBase2D(value_type x) {
    data1D_ = x;
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF>::FixedArrayBase2D(Value<T> x)
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>::FixedArrayBase2D(Value<T> x)
     : FixedArrayBase2D(x.get()) {
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF>::FixedArrayBase2D(
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>::FixedArrayBase2D(
     use::List2D<builtin_type> list) {
    ASSERT_STRICT_DEBUG(valid_list2D(list));
    auto [nrows, ncols] = list2D_row_col_sizes(list);
@@ -102,16 +123,16 @@ STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF>::FixedArrayBase2D(
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF>::FixedArrayBase2D(
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>::FixedArrayBase2D(
     TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
    copy(A, *this);
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF>& FixedArrayBase2D<T, M, N, AF>::operator=(
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>& FixedArrayBase2D<T, M, N, AF, L>::operator=(
     value_type x) {
    data1D_ = x;
    return *this;
@@ -119,8 +140,8 @@ STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF>& FixedArrayBase2D<T, M, N, AF>::o
 
 
 // Handles empty initializer list case as well.
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF>& FixedArrayBase2D<T, M, N, AF>::operator=(
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>& FixedArrayBase2D<T, M, N, AF, L>::operator=(
     use::List2D<T> list) {
    // Constructor of temp checks that list is valid and that it is of size M x N, same_size not
    // needed.
@@ -129,8 +150,8 @@ STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF>& FixedArrayBase2D<T, M, N, AF>::o
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF>& FixedArrayBase2D<T, M, N, AF>::operator=(
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF, L>& FixedArrayBase2D<T, M, N, AF, L>::operator=(
     TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
    copy(A, *this);
@@ -138,76 +159,146 @@ STRICT_CONSTEXPR FixedArrayBase2D<T, M, N, AF>& FixedArrayBase2D<T, M, N, AF>::o
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t FixedArrayBase2D<T, M, N, AF>::rows() {
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t FixedArrayBase2D<T, M, N, AF, L>::rows() {
    return M.get();
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t FixedArrayBase2D<T, M, N, AF>::cols() {
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t FixedArrayBase2D<T, M, N, AF, L>::cols() {
    return N.get();
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t FixedArrayBase2D<T, M, N, AF>::size() {
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_CONSTEXPR_INLINE index_t FixedArrayBase2D<T, M, N, AF, L>::size() {
    return M.get() * N.get();
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF>::un(ImplicitInt i)
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF, L>::un(ImplicitInt i)
     -> value_type& {
-   return data1D_.un(i);
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i);
+   } else {
+      auto [r, c] = index_map_one_to_two_dim(*this, i);
+      return this->un(r, c);
+   }
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF>::un(ImplicitInt i) const
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF, L>::un(ImplicitInt i) const
     -> const value_type& {
-   return data1D_.un(i);
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i);
+   } else {
+      auto [r, c] = index_map_one_to_two_dim(*this, i);
+      return this->un(r, c);
+   }
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF>::un(ImplicitInt i,
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF, L>::un(ImplicitInt i,
                                                                          ImplicitInt j)
     -> value_type& {
-   return data1D_.un(i.get() * N.get() + j.get());
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i.get() * N.get() + j.get());
+   } else {
+      return data1D_.un(j.get() * M.get() + i.get());
+   }
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF>::un(ImplicitInt i,
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto FixedArrayBase2D<T, M, N, AF, L>::un(ImplicitInt i,
                                                                          ImplicitInt j) const
     -> const value_type& {
-   return data1D_.un(i.get() * N.get() + j.get());
+   if constexpr(L == RowMajor) {
+      return data1D_.un(i.get() * N.get() + j.get());
+   } else {
+      return data1D_.un(j.get() * M.get() + i.get());
+   }
+}
+
+
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_INLINE auto FixedArrayBase2D<T, M, N, AF, L>::load_packet(ImplicitInt i) const -> Packet<T>
+   requires(PacketBuiltin<T> && L == RowMajor)
+{
+   return data1D_.load_packet(i);
+}
+
+
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_INLINE void FixedArrayBase2D<T, M, N, AF, L>::store_packet(ImplicitInt i, Packet<T> x)
+   requires(PacketBuiltin<T> && L == RowMajor)
+{
+   data1D_.store_packet(i, x);
+}
+
+
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF, L>::col_data(ImplicitInt j) &
+    -> value_type*
+   requires(L == ColMajor)
+{
+   return data1D_.data() + (j.get() * M.get()).val();
+}
+
+
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF, L>::col_data(ImplicitInt j) const&
+    -> const value_type*
+   requires(L == ColMajor)
+{
+   return data1D_.data() + (j.get() * M.get()).val();
+}
+
+
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF, L>::storage() &
+    -> FixedArrayBase1D<T, M.get() * N.get(), AF>&
+   requires(L == ColMajor)
+{
+   return data1D_;
+}
+
+
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF, L>::storage() const&
+    -> const FixedArrayBase1D<T, M.get() * N.get(), AF>&
+   requires(L == ColMajor)
+{
+   return data1D_;
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF>::data() & -> value_type* {
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF, L>::data() & -> value_type* {
    return data1D_.data();
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF>::data() const& -> const value_type* {
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD_CONSTEXPR auto FixedArrayBase2D<T, M, N, AF, L>::data() const& -> const value_type* {
    return data1D_.data();
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD auto FixedArrayBase2D<T, M, N, AF>::blas_data() & -> builtin_type*
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD auto FixedArrayBase2D<T, M, N, AF, L>::blas_data() & -> builtin_type*
    requires CompatibleBuiltin<T>
 {
    return data1D_.blas_data();
 }
 
 
-template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF>
-STRICT_NODISCARD auto FixedArrayBase2D<T, M, N, AF>::blas_data() const& -> const builtin_type*
+template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF, Layout L>
+STRICT_NODISCARD auto FixedArrayBase2D<T, M, N, AF, L>::blas_data() const& -> const builtin_type*
    requires CompatibleBuiltin<T>
 {
    return data1D_.blas_data();
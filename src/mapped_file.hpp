@@ -0,0 +1,233 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "ArrayCommon/array_auxiliary.hpp"
+#include "ArrayCommon/array_traits.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "attach1D.hpp"
+#include "attach2D.hpp"
+
+
+namespace spp {
+
+
+// Writes to CopyOnWrite mappings are private to the process, writes to ReadWrite mappings
+// are carried through to the file. ReadOnly mappings can only be attached as constant arrays.
+enum class MapMode { ReadOnly, CopyOnWrite, ReadWrite };
+
+
+enum class MapAdvice { Normal, Sequential, Random, WillNeed };
+
+
+// Maps the whole file into memory. Pages are read from the file when first touched, so
+// mapping is fast regardless of the file size, and read-only mappings of the same file are
+// shared between processes. Arrays attached to the mapping must not outlive it.
+class STRICT_NODISCARD MappedFile {
+public:
+   explicit MappedFile(const std::string& file_path, MapMode mode = MapMode::ReadOnly)
+       : mode_{mode} {
+      const int fd = ::open(file_path.c_str(), mode == MapMode::ReadWrite ? O_RDWR : O_RDONLY);
+      ASSERT_STRICT_ALWAYS_MSG(fd != -1, "Invalid file path.\n");
+      struct stat st {};
+      if(::fstat(fd, &st) != 0) {
+         ::close(fd);
+         ASSERT_STRICT_ALWAYS_MSG(false, "Cannot determine the size of the file.\n");
+      }
+      this->map(fd, std::size_t(st.st_size));
+   }
+
+   // Creates file_path, or truncates it if it exists, to size bytes and maps it for reading
+   // and writing. The file is filled with zeros.
+   STRICT_NODISCARD static MappedFile create(const std::string& file_path, std::size_t size) {
+      const int fd = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+      ASSERT_STRICT_ALWAYS_MSG(fd != -1, "Invalid file path.\n");
+      if(::ftruncate(fd, off_t(size)) != 0) {
+         ::close(fd);
+         ASSERT_STRICT_ALWAYS_MSG(false, "Cannot resize the file.\n");
+      }
+      MappedFile file;
+      file.mode_ = MapMode::ReadWrite;
+      file.map(fd, size);
+      return file;
+   }
+
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   MappedFile(MappedFile&& file) noexcept
+       : data_{std::exchange(file.data_, nullptr)},
+         size_{std::exchange(file.size_, 0)},
+         mode_{file.mode_} {
+   }
+
+   MappedFile& operator=(MappedFile&& file) noexcept {
+      if(this != &file) {
+         this->unmap();
+         data_ = std::exchange(file.data_, nullptr);
+         size_ = std::exchange(file.size_, 0);
+         mode_ = file.mode_;
+      }
+      return *this;
+   }
+
+   ~MappedFile() {
+      this->unmap();
+   }
+
+   std::size_t size() const {
+      return size_;
+   }
+
+   MapMode mode() const {
+      return mode_;
+   }
+
+   // Pointer to the byte at offset, which must be aligned for T.
+   template <typename T>
+   STRICT_NODISCARD T* data(std::size_t offset = 0) & {
+      ASSERT_STRICT_ALWAYS_MSG(mode_ != MapMode::ReadOnly,
+                               "Read-only mapping must be accessed as constant.\n");
+      return const_cast<T*>(std::as_const(*this).template data<T>(offset));
+   }
+
+   template <typename T>
+   STRICT_NODISCARD const T* data(std::size_t offset = 0) const& {
+      ASSERT_STRICT_ALWAYS(offset <= size_);
+      ASSERT_STRICT_ALWAYS_MSG(offset % alignof(T) == 0, "Misaligned offset.\n");
+      return reinterpret_cast<const T*>(static_cast<const char*>(data_) + offset);
+   }
+
+   // Hints how bytes [offset, offset + len) are going to be accessed. Sequential enables
+   // aggressive read-ahead, Random disables it, WillNeed starts reading the range in the
+   // background. Hints are ignored if the kernel does not support them.
+   void advise(MapAdvice advice, std::size_t offset = 0, std::size_t len = std::size_t(-1)) {
+      if(data_ == nullptr || offset >= size_) {
+         return;
+      }
+      len = std::min(len, size_ - offset);
+      // madvise requires a page aligned address.
+      const std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+      const std::size_t first = offset / page * page;
+      ::madvise(static_cast<char*>(data_) + first, len + (offset - first), native_advice(advice));
+   }
+
+   // Writes modified pages of a ReadWrite mapping to the file and waits for completion.
+   void sync() {
+      if(data_ != nullptr && mode_ == MapMode::ReadWrite) {
+         ASSERT_STRICT_ALWAYS_MSG(::msync(data_, size_, MS_SYNC) == 0,
+                                  "Cannot write the mapping to the file.\n");
+      }
+   }
+
+private:
+   void* data_{};
+   std::size_t size_{};
+   MapMode mode_{MapMode::ReadOnly};
+
+   MappedFile() = default;
+
+   // The mapping keeps the file open, so fd is closed in any case. Empty files are not
+   // mapped.
+   void map(int fd, std::size_t size) {
+      if(size != 0) {
+         const int prot = mode_ == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+         const int flags = mode_ == MapMode::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+         void* p = ::mmap(nullptr, size, prot, flags, fd, 0);
+         ::close(fd);
+         ASSERT_STRICT_ALWAYS_MSG(p != MAP_FAILED, "Cannot map the file.\n");
+         data_ = p;
+         size_ = size;
+      } else {
+         ::close(fd);
+      }
+   }
+
+   void unmap() {
+      if(data_ != nullptr) {
+         ::munmap(data_, size_);
+      }
+   }
+
+   static int native_advice(MapAdvice advice) {
+      switch(advice) {
+      case MapAdvice::Sequential:
+         return MADV_SEQUENTIAL;
+      case MapAdvice::Random:
+         return MADV_RANDOM;
+      case MapAdvice::WillNeed:
+         return MADV_WILLNEED;
+      default:
+         return MADV_NORMAL;
+      }
+   }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// n elements of type T stored in the file starting from byte offset.
+template <detail::CompatibleBuiltin T>
+auto attach1D(MappedFile& file, ImplicitInt n, std::size_t offset = 0) {
+   ASSERT_STRICT_ALWAYS(offset <= file.size());
+   ASSERT_STRICT_ALWAYS(detail::fits_in_bytes(1_sl, n.get(), sizeof(T), file.size() - offset));
+   T* p = file.data<T>(offset);
+   return attach1D(p, n);
+}
+
+
+template <detail::CompatibleBuiltin T>
+auto attach1D(const MappedFile& file, ImplicitInt n, std::size_t offset = 0) {
+   ASSERT_STRICT_ALWAYS(offset <= file.size());
+   ASSERT_STRICT_ALWAYS(detail::fits_in_bytes(1_sl, n.get(), sizeof(T), file.size() - offset));
+   const T* p = file.data<T>(offset);
+   return attach1D(p, n);
+}
+
+
+// All elements of type T stored in the file.
+template <detail::CompatibleBuiltin T>
+auto attach1D(MappedFile& file) {
+   return attach1D<T>(file, to_index_t(file.size() / sizeof(T)));
+}
+
+
+template <detail::CompatibleBuiltin T>
+auto attach1D(const MappedFile& file) {
+   return attach1D<T>(file, to_index_t(file.size() / sizeof(T)));
+}
+
+
+// m x n elements of type T stored in the order given by L starting from byte offset.
+template <detail::CompatibleBuiltin T, Layout L = RowMajor>
+auto attach2D(MappedFile& file, ImplicitInt m, ImplicitInt n, std::size_t offset = 0) {
+   ASSERT_STRICT_ALWAYS(offset <= file.size());
+   ASSERT_STRICT_ALWAYS(detail::fits_in_bytes(m.get(), n.get(), sizeof(T), file.size() - offset));
+   T* p = file.data<T>(offset);
+   return attach2D<L>(p, m, n);
+}
+
+
+template <detail::CompatibleBuiltin T, Layout L = RowMajor>
+auto attach2D(const MappedFile& file, ImplicitInt m, ImplicitInt n, std::size_t offset = 0) {
+   ASSERT_STRICT_ALWAYS(offset <= file.size());
+   ASSERT_STRICT_ALWAYS(detail::fits_in_bytes(m.get(), n.get(), sizeof(T), file.size() - offset));
+   const T* p = file.data<T>(offset);
+   return attach2D<L>(p, m, n);
+}
+
+
+}  // namespace spp
+#endif
@@ -0,0 +1,349 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+
+#if defined STRICT_SIMD_PACKETS && (defined __FMA__ || defined __AVX512F__)
+#include <immintrin.h>
+#endif
+
+
+namespace spp {
+
+
+// Matrix-matrix product of any two-dimensional objects, e.g. arrays, slices, and transposes.
+// Each element of the result is accumulated in the order of the inner index, so results
+// do not depend on blocking or the number of threads. Multiply-add is fused if the target
+// supports it and elements are evaluated in packets, see detail::matmul_madd.
+template <TwoDimRealBaseType Base1, TwoDimRealBaseType Base2>
+   requires SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+auto matmul(const Base1& A, const Base2& B);
+
+
+namespace detail {
+
+
+template <typename T>
+struct PacketFma {
+   static constexpr bool enabled = false;
+};
+
+
+#if defined STRICT_SIMD_PACKETS && STRICT_SIMD_BYTES == 64
+template <>
+struct PacketFma<double> {
+   static constexpr bool enabled = true;
+
+   static Packet<double> madd(Packet<double> x, Packet<double> y, Packet<double> z) {
+      return std::bit_cast<Packet<double>>(_mm512_fmadd_pd(
+          std::bit_cast<__m512d>(x), std::bit_cast<__m512d>(y), std::bit_cast<__m512d>(z)));
+   }
+};
+
+
+template <>
+struct PacketFma<float> {
+   static constexpr bool enabled = true;
+
+   static Packet<float> madd(Packet<float> x, Packet<float> y, Packet<float> z) {
+      return std::bit_cast<Packet<float>>(_mm512_fmadd_ps(
+          std::bit_cast<__m512>(x), std::bit_cast<__m512>(y), std::bit_cast<__m512>(z)));
+   }
+};
+
+
+#elif defined STRICT_SIMD_PACKETS && STRICT_SIMD_BYTES == 32 && defined __FMA__
+template <>
+struct PacketFma<double> {
+   static constexpr bool enabled = true;
+
+   static Packet<double> madd(Packet<double> x, Packet<double> y, Packet<double> z) {
+      return std::bit_cast<Packet<double>>(_mm256_fmadd_pd(
+          std::bit_cast<__m256d>(x), std::bit_cast<__m256d>(y), std::bit_cast<__m256d>(z)));
+   }
+};
+
+
+template <>
+struct PacketFma<float> {
+   static constexpr bool enabled = true;
+
+   static Packet<float> madd(Packet<float> x, Packet<float> y, Packet<float> z) {
+      return std::bit_cast<Packet<float>>(_mm256_fmadd_ps(
+          std::bit_cast<__m256>(x), std::bit_cast<__m256>(y), std::bit_cast<__m256>(z)));
+   }
+};
+
+
+#elif defined STRICT_SIMD_PACKETS && STRICT_SIMD_BYTES == 16 && defined __FMA__
+template <>
+struct PacketFma<double> {
+   static constexpr bool enabled = true;
+
+   static Packet<double> madd(Packet<double> x, Packet<double> y, Packet<double> z) {
+      return std::bit_cast<Packet<double>>(_mm_fmadd_pd(
+          std::bit_cast<__m128d>(x), std::bit_cast<__m128d>(y), std::bit_cast<__m128d>(z)));
+   }
+};
+
+
+template <>
+struct PacketFma<float> {
+   static constexpr bool enabled = true;
+
+   static Packet<float> madd(Packet<float> x, Packet<float> y, Packet<float> z) {
+      return std::bit_cast<Packet<float>>(_mm_fmadd_ps(
+          std::bit_cast<__m128>(x), std::bit_cast<__m128>(y), std::bit_cast<__m128>(z)));
+   }
+};
+#endif
+
+
+// x * y + z, rounded once if packets of T use fused multiply-add.
+template <Builtin T>
+STRICT_INLINE Strict<T> matmul_madd(Strict<T> x, Strict<T> y, Strict<T> z) {
+   if constexpr(PacketFma<T>::enabled) {
+      return Strict<T>{std::fma(x.val(), y.val(), z.val())};
+   } else {
+      return x * y + z;
+   }
+}
+
+
+template <PacketBuiltin T>
+STRICT_NODISCARD_INLINE Packet<T> matmul_madd(Packet<T> x, Packet<T> y, Packet<T> z) {
+   if constexpr(PacketFma<T>::enabled) {
+      return PacketFma<T>::madd(x, y, z);
+   } else {
+      return x * y + z;
+   }
+}
+
+
+// Element by element evaluation for types that are not evaluated in packets.
+template <TwoDimBaseType Base1, TwoDimBaseType Base2, typename T>
+void matmul_generic(const Base1& A, const Base2& B, Array2D<T>& C) {
+   for(index_t i = 0_sl; i < C.rows(); ++i) {
+      for(index_t k = 0_sl; k < A.cols(); ++k) {
+         const auto a = A.un(i, k);
+         for(index_t j = 0_sl; j < C.cols(); ++j) {
+            C.un(i, j) = matmul_madd(a, B.un(k, j), C.un(i, j));
+         }
+      }
+   }
+}
+
+
+// The microkernel computes gemm_mr x gemm_nr<T> blocks of C in registers,
+// gemm_np packets per row. Blocks of A of gemm_mc x gemm_kc elements are packed
+// so that they stay in L2 cache, and panels of B of gemm_kc x gemm_nc elements
+// so that they stay in L3 cache.
+#if STRICT_SIMD_BYTES == 64
+inline constexpr long int gemm_mr{12L};
+#else
+inline constexpr long int gemm_mr{6L};
+#endif
+inline constexpr long int gemm_np{2L};
+inline constexpr long int gemm_kc{256L};
+inline constexpr long int gemm_mc{16L * gemm_mr};
+inline constexpr long int gemm_nc{2048L};
+
+
+template <PacketBuiltin T>
+consteval long int gemm_nr() {
+   return gemm_np * packet_size<T>();
+}
+
+
+// Packs rows [i0, i0 + mc) and columns [k0, k0 + kc) of A into panels of gemm_mr rows,
+// each stored column by column. Rows past the end of A are zero.
+template <TwoDimBaseType Base>
+void pack_lhs(const Base& A, index_t i0, index_t k0, long int mc, long int kc,
+              ValueTypeOf<Base>* STRICT_RESTRICT p) {
+   for(long int ir = 0; ir < mc; ir += gemm_mr) {
+      const long int mr = std::min(gemm_mr, mc - ir);
+      for(long int k = 0; k < kc; ++k) {
+         for(long int r = 0; r < mr; ++r) {
+            p[r] = A.un(i0 + index_t{ir + r}, k0 + index_t{k});
+         }
+         for(long int r = mr; r < gemm_mr; ++r) {
+            p[r] = ValueTypeOf<Base>{};
+         }
+         p += gemm_mr;
+      }
+   }
+}
+
+
+// Packs rows [k0, k0 + kc) and columns [j0, j0 + nc) of B into panels of gemm_nr columns,
+// each stored row by row. Columns past the end of B are zero.
+template <TwoDimBaseType Base>
+void pack_rhs(const Base& B, index_t k0, index_t j0, long int kc, long int nc,
+              ValueTypeOf<Base>* STRICT_RESTRICT p) {
+   constexpr long int NR = gemm_nr<BuiltinTypeOf<Base>>();
+   for(long int jr = 0; jr < nc; jr += NR) {
+      const long int nr = std::min(NR, nc - jr);
+      for(long int k = 0; k < kc; ++k) {
+         for(long int c = 0; c < nr; ++c) {
+            p[c] = B.un(k0 + index_t{k}, j0 + index_t{jr + c});
+         }
+         for(long int c = nr; c < NR; ++c) {
+            p[c] = ValueTypeOf<Base>{};
+         }
+         p += NR;
+      }
+   }
+}
+
+
+// Adds products of packed panels a and b to the gemm_mr x gemm_nr<T> block of C at c.
+template <PacketBuiltin T>
+STRICT_INLINE void gemm_kernel(long int kc, const Strict<T>* STRICT_RESTRICT a,
+                               const Strict<T>* STRICT_RESTRICT b, Strict<T>* STRICT_RESTRICT c,
+                               long int ldc) {
+   constexpr long int W = packet_size<T>();
+   constexpr long int NR = gemm_nr<T>();
+
+   Packet<T> acc[gemm_mr][gemm_np];
+   for(long int r = 0; r < gemm_mr; ++r) {
+      for(long int u = 0; u < gemm_np; ++u) {
+         acc[r][u] = load_packet<Unaligned>(c + r * ldc + u * W);
+      }
+   }
+
+   for(long int k = 0; k < kc; ++k) {
+      Packet<T> y[gemm_np];
+      for(long int u = 0; u < gemm_np; ++u) {
+         y[u] = load_packet<Aligned>(b + k * NR + u * W);
+      }
+      for(long int r = 0; r < gemm_mr; ++r) {
+         const Packet<T> x = broadcast_packet(a[k * gemm_mr + r]);
+         for(long int u = 0; u < gemm_np; ++u) {
+            acc[r][u] = matmul_madd<T>(x, y[u], acc[r][u]);
+         }
+      }
+   }
+
+   for(long int r = 0; r < gemm_mr; ++r) {
+      for(long int u = 0; u < gemm_np; ++u) {
+         store_packet<Unaligned>(c + r * ldc + u * W, acc[r][u]);
+      }
+   }
+}
+
+
+// Blocks at the edges of C, which have only mr rows and nr columns, are accumulated in
+// a temporary block so that all elements use the same operations.
+template <PacketBuiltin T>
+void gemm_kernel_edge(long int kc, const Strict<T>* STRICT_RESTRICT a,
+                      const Strict<T>* STRICT_RESTRICT b, Strict<T>* STRICT_RESTRICT c,
+                      long int ldc, long int mr, long int nr) {
+   constexpr long int NR = gemm_nr<T>();
+   Strict<T> edge[std::size_t(gemm_mr * NR)];
+   for(long int r = 0; r < mr; ++r) {
+      for(long int l = 0; l < nr; ++l) {
+         edge[r * NR + l] = c[r * ldc + l];
+      }
+   }
+
+   gemm_kernel<T>(kc, a, b, edge, NR);
+
+   for(long int r = 0; r < mr; ++r) {
+      for(long int l = 0; l < nr; ++l) {
+         c[r * ldc + l] = edge[r * NR + l];
+      }
+   }
+}
+
+
+// Rows [first, last) of C, where first is a multiple of gemm_mc, are updated by
+// products of the corresponding rows of A and the packed panel of B.
+template <TwoDimBaseType Base, typename T>
+void gemm_rows(const Base& A, const Strict<T>* STRICT_RESTRICT pb, Array2D<T>& C,
+               index_t first, index_t last, index_t k0, index_t j0, long int kc, long int nc) {
+   constexpr long int NR = gemm_nr<T>();
+   const long int ldc = C.cols().val();
+   const long int mc_max = std::min(gemm_mc, (last - first).val());
+   Array1D<T, Aligned> pa((mc_max + gemm_mr - 1) / gemm_mr * gemm_mr * kc);
+
+   for(index_t i0 = first; i0 < last; i0 += index_t{gemm_mc}) {
+      const long int mc = std::min(gemm_mc, (last - i0).val());
+      pack_lhs(A, i0, k0, mc, kc, pa.data());
+      for(long int jr = 0; jr < nc; jr += NR) {
+         for(long int ir = 0; ir < mc; ir += gemm_mr) {
+            const long int mr = std::min(gemm_mr, mc - ir);
+            const long int nr = std::min(NR, nc - jr);
+            auto* c = C.data() + (i0.val() + ir) * ldc + j0.val() + jr;
+            if(mr == gemm_mr && nr == NR) {
+               gemm_kernel<T>(kc, pa.data() + ir * kc, pb + jr * kc, c, ldc);
+            } else {
+               gemm_kernel_edge<T>(kc, pa.data() + ir * kc, pb + jr * kc, c, ldc, mr, nr);
+            }
+         }
+      }
+   }
+}
+
+
+template <TwoDimBaseType Base1, TwoDimBaseType Base2, typename T>
+void matmul_packet(const Base1& A, const Base2& B, Array2D<T>& C) {
+   constexpr long int NR = gemm_nr<T>();
+   const index_t m = C.rows();
+   const index_t n = C.cols();
+   const index_t p = A.cols();
+   const bool parallel = use_parallel<Array2D<T>, Base1, Base2>(C.size());
+
+   const long int nc_max = std::min(gemm_nc, (n.val() + NR - 1) / NR * NR);
+   Array1D<T, Aligned> pb(std::min(gemm_kc, p.val()) * nc_max);
+
+   for(index_t j0 = 0_sl; j0 < n; j0 += index_t{gemm_nc}) {
+      const long int nc = std::min(gemm_nc, (n - j0).val());
+      for(index_t k0 = 0_sl; k0 < p; k0 += index_t{gemm_kc}) {
+         const long int kc = std::min(gemm_kc, (p - k0).val());
+         pack_rhs(B, k0, j0, kc, nc, pb.data());
+         auto rows = [&](index_t first, index_t last) {
+            gemm_rows(A, pb.data(), C, first, last, k0, j0, kc, nc);
+         };
+         if(parallel) {
+            parallel_for(m, index_t{gemm_mc}, rows);
+         } else {
+            rows(0_sl, m);
+         }
+      }
+   }
+}
+
+
+}  // namespace detail
+
+
+template <TwoDimRealBaseType Base1, TwoDimRealBaseType Base2>
+   requires SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+auto matmul(const Base1& A, const Base2& B) {
+   ASSERT_STRICT_DEBUG(A.cols() == B.rows());
+   using T = BuiltinTypeOf<Base1>;
+   if(A.rows() == 0_sl || B.cols() == 0_sl) {
+      return Array2D<T>{};
+   }
+
+   Array2D<T> C(A.rows(), B.cols());
+   if constexpr(detail::PacketBuiltin<T>) {
+      detail::matmul_packet(A, B, C);
+   } else {
+      detail::matmul_generic(A, B, C);
+   }
+   return C;
+}
+
+
+}  // namespace spp
@@ -0,0 +1,380 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "array_IO.hpp"
+#include "binary_IO.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+#include "mapped_file.hpp"
+
+
+namespace spp {
+
+
+// NumPy .npy files. Elements are stored with their native size and byte order: bool as b1,
+// integers as i or u, float, double, and long double as f, the latter matching NumPy's
+// longdouble on the same platform. NumPy has no quadruple precision type, so float128 is
+// stored as 16-byte void elements. Column-major arrays are stored in Fortran order, other
+// two-dimensional objects in C order.
+void save_npy(const std::string& file_path, BaseType auto const& A);
+
+
+template <Builtin T, AlignmentFlag AF>
+void load_npy(const std::string& file_path, Array1D<T, AF>& A);
+
+
+// Files in C and Fortran order can be loaded into arrays of either layout.
+template <Builtin T, AlignmentFlag AF, Layout L>
+void load_npy(const std::string& file_path, Array2D<T, AF, L>& A);
+
+
+// Fixed arrays and slices are not resized, the file must have the same dimensions.
+template <typename Base>
+   requires(detail::NonConstBaseType<RemoveCVRef<Base>>
+            && !detail::has_resize<RemoveCVRef<Base>>::value)
+void load_npy(const std::string& file_path, Base&& A);
+
+
+namespace detail {
+
+
+inline constexpr char npy_magic[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+
+// Headers are padded so that elements start at a multiple of this many bytes, which allows
+// mapped files to be attached for every element type.
+inline constexpr std::size_t npy_alignment = 64;
+
+
+struct NpyHeader {
+   std::string descr;
+   bool fortran_order{};
+   std::vector<long int> shape;
+   std::size_t data_offset{};
+};
+
+
+template <Builtin T>
+std::string npy_descr() {
+   const char order = sizeof(T) == 1 ? '|' : (native_little_endian ? '<' : '>');
+   if constexpr(Boolean<T>) {
+      return "|b1";
+   } else if constexpr(SignedInteger<T>) {
+      return order + std::string{"i"} + std::to_string(sizeof(T));
+   } else if constexpr(UnsignedInteger<T>) {
+      return order + std::string{"u"} + std::to_string(sizeof(T));
+   } else if constexpr(StandardFloating<T>) {
+      return order + std::string{"f"} + std::to_string(sizeof(T));
+   } else {
+      return "|V" + std::to_string(sizeof(T));
+   }
+}
+
+
+inline std::string npy_dict(const std::string& descr, bool fortran_order,
+                            const std::vector<long int>& shape) {
+   std::string dict = "{'descr': '" + descr + "', 'fortran_order': "
+                    + (fortran_order ? "True" : "False") + ", 'shape': (";
+   for(std::size_t k = 0; k < shape.size(); ++k) {
+      dict += std::to_string(shape[k]) + (shape.size() == 1 || k + 1 < shape.size() ? "," : "");
+      dict += k + 1 < shape.size() ? " " : "";
+   }
+   return dict + "), }";
+}
+
+
+// Version 1.0 stores the length of the header in 2 bytes, version 2.0 in 4 bytes. Lengths
+// are little-endian regardless of the byte order of the elements.
+inline void write_npy_header(std::FILE* f, const std::string& dict) {
+   std::size_t preamble = 10;
+   std::size_t len = dict.size() + 1;
+   if(preamble + len > 65535) {
+      preamble = 12;
+   }
+   len += (npy_alignment - (preamble + len) % npy_alignment) % npy_alignment;
+
+   unsigned char version[2] = {preamble == 10 ? std::uint8_t(1) : std::uint8_t(2), 0};
+   unsigned char bytes[4];
+   for(std::size_t k = 0; k < 4; ++k) {
+      bytes[k] = static_cast<unsigned char>(len >> (8 * k));
+   }
+   std::string header = dict;
+   header.resize(len - 1, ' ');
+   header += '\n';
+
+   write_bytes(f, npy_magic, sizeof(npy_magic));
+   write_bytes(f, version, sizeof(version));
+   write_bytes(f, bytes, preamble - 8);
+   write_bytes(f, header.data(), header.size());
+}
+
+
+// Returns the size of the preamble, i.e. of the magic string, version, and length of the
+// header, given its first 8 bytes.
+inline std::size_t npy_preamble_size(const char* p) {
+   ASSERT_STRICT_ALWAYS_MSG(std::memcmp(p, npy_magic, sizeof(npy_magic)) == 0,
+                            "Invalid npy file.\n");
+   ASSERT_STRICT_ALWAYS_MSG(p[6] >= 1 && p[6] <= 3, "Unsupported npy file version.\n");
+   return p[6] == 1 ? 10 : 12;
+}
+
+
+inline std::size_t npy_header_length(const char* p, std::size_t preamble) {
+   std::size_t len = 0;
+   for(std::size_t k = preamble - 8; k-- > 0;) {
+      len = len << 8 | static_cast<unsigned char>(p[8 + k]);
+   }
+   return len;
+}
+
+
+// Returns the value of key in the dictionary of the header, i.e. the text from the colon
+// following the key up to, but not including, the next comma outside of parentheses.
+inline std::string_view npy_value(std::string_view dict, std::string_view key) {
+   std::size_t k = dict.find("'" + std::string{key} + "'");
+   if(k == std::string_view::npos) {
+      k = dict.find("\"" + std::string{key} + "\"");
+   }
+   ASSERT_STRICT_ALWAYS_MSG(k != std::string_view::npos, "Invalid npy file.\n");
+   k = dict.find(':', k + key.size() + 2);
+   ASSERT_STRICT_ALWAYS_MSG(k != std::string_view::npos, "Invalid npy file.\n");
+
+   std::size_t last = ++k;
+   for(int depth = 0; last < dict.size(); ++last) {
+      const char c = dict[last];
+      depth += c == '(' ? 1 : (c == ')' ? -1 : 0);
+      if(depth == 0 && (c == ',' || c == '}')) {
+         break;
+      }
+   }
+   std::string_view value = dict.substr(k, last - k);
+   while(!value.empty() && is_text_space(value.front())) {
+      value.remove_prefix(1);
+   }
+   while(!value.empty() && is_text_space(value.back())) {
+      value.remove_suffix(1);
+   }
+   return value;
+}
+
+
+inline NpyHeader parse_npy_header(std::string_view dict, std::size_t data_offset) {
+   NpyHeader h;
+   h.data_offset = data_offset;
+
+   const std::string_view descr = npy_value(dict, "descr");
+   ASSERT_STRICT_ALWAYS_MSG(descr.size() >= 2 && (descr.front() == '\'' || descr.front() == '"')
+                                && descr.back() == descr.front(),
+                            "Invalid npy file.\n");
+   h.descr = descr.substr(1, descr.size() - 2);
+
+   const std::string_view order = npy_value(dict, "fortran_order");
+   ASSERT_STRICT_ALWAYS_MSG(order == "True" || order == "False", "Invalid npy file.\n");
+   h.fortran_order = order == "True";
+
+   std::string_view shape = npy_value(dict, "shape");
+   ASSERT_STRICT_ALWAYS_MSG(shape.size() >= 2 && shape.front() == '(' && shape.back() == ')',
+                            "Invalid npy file.\n");
+   shape = shape.substr(1, shape.size() - 2);
+   const char* first = shape.data();
+   const char* last = shape.data() + shape.size();
+   while((first = skip_text_spaces(first, last)) != last) {
+      long int n{};
+      const auto [ptr, ec] = std::from_chars(first, last, n);
+      ASSERT_STRICT_ALWAYS_MSG(ec == std::errc{} && n >= 0, "Invalid npy file.\n");
+      h.shape.push_back(n);
+      first = skip_text_spaces(ptr, last);
+      if(first != last) {
+         ASSERT_STRICT_ALWAYS_MSG(*first == ',', "Invalid npy file.\n");
+         ++first;
+      }
+   }
+   return h;
+}
+
+
+inline NpyHeader read_npy_header(std::FILE* f) {
+   char preamble[12];
+   read_bytes(f, preamble, 8);
+   const std::size_t size = npy_preamble_size(preamble);
+   read_bytes(f, preamble + 8, size - 8);
+   const std::size_t len = npy_header_length(preamble, size);
+   ASSERT_STRICT_ALWAYS_MSG(len <= remaining_bytes(f), "Unexpected end of the file.\n");
+   std::string dict(len, ' ');
+   read_bytes(f, dict.data(), dict.size());
+   return parse_npy_header(dict, size + dict.size());
+}
+
+
+// Returns true if elements are stored in the opposite byte order.
+template <Builtin T>
+bool validate_npy_header(const NpyHeader& h, std::size_t rank) {
+   const std::string expected = npy_descr<T>();
+   std::string_view descr = h.descr;
+   ASSERT_STRICT_ALWAYS_MSG(!descr.empty(), "Invalid npy file.\n");
+   const char order = descr.front();
+   const bool swap = sizeof(T) > 1 && order == (native_little_endian ? '>' : '<');
+   if(order == '<' || order == '>' || order == '|' || order == '=') {
+      descr.remove_prefix(1);
+   }
+   ASSERT_STRICT_ALWAYS_MSG(descr == std::string_view{expected}.substr(1),
+                            "Type of the npy file does not match.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.shape.size() == rank, "Dimension of the npy file does not match.\n");
+   return swap;
+}
+
+
+// Elements are read as those of binary files with the same layout and byte order.
+inline BinaryHeader npy_binary_header(const NpyHeader& h, bool swap) {
+   BinaryHeader b{};
+   b.rank = std::uint8_t(h.shape.size());
+   b.layout = std::uint8_t(h.fortran_order ? ColMajor : RowMajor);
+   b.little_endian = swap != native_little_endian;
+   return b;
+}
+
+
+}  // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void save_npy(const std::string& file_path, BaseType auto const& A) {
+   using Base = RemoveCVRef<decltype(A)>;
+   using T = BuiltinTypeOf<Base>;
+   std::vector<long int> shape;
+   bool fortran_order = false;
+   if constexpr(OneDimBaseType<Base>) {
+      shape = {A.size().val()};
+   } else {
+      shape = {A.rows().val(), A.cols().val()};
+      fortran_order = detail::ColContiguousBaseType<Base>;
+   }
+
+   auto f = detail::open_binary(file_path, "wb");
+   detail::write_npy_header(f.get(), detail::npy_dict(detail::npy_descr<T>(), fortran_order, shape));
+   detail::write_binary_elements(f.get(), A, fortran_order);
+   ASSERT_STRICT_ALWAYS_MSG(std::fclose(f.release()) == 0, "Cannot write to the file.\n");
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+void load_npy(const std::string& file_path, Array1D<T, AF>& A) {
+   auto f = detail::open_binary(file_path, "rb");
+   const detail::NpyHeader h = detail::read_npy_header(f.get());
+   const bool swap = detail::validate_npy_header<T>(h, 1);
+   detail::check_remaining_elements<T>(f.get(), 1_sl, index_t{h.shape[0]});
+
+   Array1D<T, AF> tmp(h.shape[0], uninitialized);
+   detail::read_binary_elements(f.get(), tmp, detail::npy_binary_header(h, swap));
+   A.swap(tmp);
+}
+
+
+template <Builtin T, AlignmentFlag AF, Layout L>
+void load_npy(const std::string& file_path, Array2D<T, AF, L>& A) {
+   auto f = detail::open_binary(file_path, "rb");
+   const detail::NpyHeader h = detail::read_npy_header(f.get());
+   const bool swap = detail::validate_npy_header<T>(h, 2);
+   detail::check_remaining_elements<T>(f.get(), index_t{h.shape[0]}, index_t{h.shape[1]});
+
+   Array2D<T, AF, L> tmp(h.shape[0], h.shape[1], uninitialized);
+   detail::read_binary_elements(f.get(), tmp, detail::npy_binary_header(h, swap));
+   A.swap(tmp);
+}
+
+
+template <typename Base>
+   requires(detail::NonConstBaseType<RemoveCVRef<Base>>
+            && !detail::has_resize<RemoveCVRef<Base>>::value)
+void load_npy(const std::string& file_path, Base&& A) {
+   using T = BuiltinTypeOf<RemoveCVRef<Base>>;
+   auto f = detail::open_binary(file_path, "rb");
+   const detail::NpyHeader h = detail::read_npy_header(f.get());
+   bool swap{};
+   if constexpr(OneDimBaseType<RemoveCVRef<Base>>) {
+      swap = detail::validate_npy_header<T>(h, 1);
+      ASSERT_STRICT_ALWAYS_MSG(h.shape[0] == A.size().val(), "Dimensions do not match.\n");
+   } else {
+      swap = detail::validate_npy_header<T>(h, 2);
+      ASSERT_STRICT_ALWAYS_MSG(h.shape[0] == A.rows().val() && h.shape[1] == A.cols().val(),
+                               "Dimensions do not match.\n");
+   }
+   detail::read_binary_elements(f.get(), A, detail::npy_binary_header(h, swap));
+}
+
+
+#ifdef __linux__
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+
+template <Builtin T>
+NpyHeader mapped_npy_header(const MappedFile& file, std::size_t rank) {
+   ASSERT_STRICT_ALWAYS_MSG(file.size() >= 12, "Invalid npy file.\n");
+   const char* p = file.data<char>();
+   const std::size_t preamble = npy_preamble_size(p);
+   const std::size_t len = npy_header_length(p, preamble);
+   ASSERT_STRICT_ALWAYS_MSG(preamble + len <= file.size(), "Invalid npy file.\n");
+
+   NpyHeader h = parse_npy_header(std::string_view{p + preamble, len}, preamble + len);
+   ASSERT_STRICT_ALWAYS_MSG(!validate_npy_header<T>(h, rank),
+                            "Npy file with different byte order cannot be mapped.\n");
+   return h;
+}
+
+
+}  // namespace detail
+
+
+// Elements of npy files are attached without reading them, see MappedFile. Files must be
+// stored in the native byte order. Two-dimensional files in C order are attached as
+// row-major, files in Fortran order as column-major, L must match the order of the file.
+template <detail::CompatibleBuiltin T>
+auto attach_npy1D(MappedFile& file) {
+   const auto h = detail::mapped_npy_header<T>(file, 1);
+   return attach1D<T>(file, h.shape[0], h.data_offset);
+}
+
+
+template <detail::CompatibleBuiltin T>
+auto attach_npy1D(const MappedFile& file) {
+   const auto h = detail::mapped_npy_header<T>(file, 1);
+   return attach1D<T>(file, h.shape[0], h.data_offset);
+}
+
+
+template <detail::CompatibleBuiltin T, Layout L = RowMajor>
+auto attach_npy2D(MappedFile& file) {
+   const auto h = detail::mapped_npy_header<T>(file, 2);
+   ASSERT_STRICT_ALWAYS_MSG(h.fortran_order == (L == ColMajor),
+                            "Order of the npy file does not match.\n");
+   return attach2D<T, L>(file, h.shape[0], h.shape[1], h.data_offset);
+}
+
+
+template <detail::CompatibleBuiltin T, Layout L = RowMajor>
+auto attach_npy2D(const MappedFile& file) {
+   const auto h = detail::mapped_npy_header<T>(file, 2);
+   ASSERT_STRICT_ALWAYS_MSG(h.fortran_order == (L == ColMajor),
+                            "Order of the npy file does not match.\n");
+   return attach2D<T, L>(file, h.shape[0], h.shape[1], h.data_offset);
+}
+#endif
+
+
+}  // namespace spp
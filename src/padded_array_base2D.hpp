@@ -0,0 +1,365 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "derived1D.hpp"
+
+
+namespace spp {
+
+
+template <typename Base>
+class StrictArray2D;
+
+
+namespace detail {
+
+
+// Row-major two-dimensional array whose rows start leading_dim() >= cols() elements apart,
+// so that every row is aligned to alignment bytes. leading_dim() is the number of columns
+// rounded up to the alignment. If rows would be a multiple of 4096 bytes apart, one more
+// alignment unit is added, so that elements in the same column of consecutive rows do not
+// map to the same cache set (4K aliasing). Padding elements are zero and are not accessed
+// by any operation. Elements are not stored contiguously, thus data() is not provided;
+// row_data(i) returns the first element of row i instead.
+template <Builtin T>
+class STRICT_NODISCARD PaddedArrayBase2D : private ReferenceBase2D, private TwoDimArrayBase {
+public:
+   using value_type = Strict<T>;
+   using builtin_type = T;
+
+   static constexpr std::size_t alignment = ArrayBase1D<T, Aligned>::alignment;
+
+   // Constructors.
+   STRICT_NODISCARD PaddedArrayBase2D() = default;
+   STRICT_NODISCARD explicit PaddedArrayBase2D(ImplicitInt m, ImplicitInt n);
+   STRICT_NODISCARD explicit PaddedArrayBase2D(Rows m, Cols n);
+   STRICT_NODISCARD explicit PaddedArrayBase2D(ImplicitInt m, ImplicitInt n, value_type x);
+   STRICT_NODISCARD explicit PaddedArrayBase2D(Rows m, Cols n, Value<T> x);
+   STRICT_NODISCARD PaddedArrayBase2D(use::List2D<builtin_type> list);
+   // Enforce parenthesis instead of braces.
+   STRICT_NODISCARD PaddedArrayBase2D(use::List1D<builtin_type> list) = delete;
+
+   STRICT_NODISCARD PaddedArrayBase2D(const PaddedArrayBase2D& A) = default;
+   STRICT_NODISCARD PaddedArrayBase2D(PaddedArrayBase2D&& A) noexcept;
+   STRICT_NODISCARD PaddedArrayBase2D(TwoDimBaseType auto const& A);
+
+   // Assignments.
+   PaddedArrayBase2D& operator=(value_type x);
+   PaddedArrayBase2D& operator=(use::List2D<builtin_type> list);
+   PaddedArrayBase2D& operator=(const PaddedArrayBase2D& A);
+   PaddedArrayBase2D& operator=(PaddedArrayBase2D&& A) noexcept;
+   PaddedArrayBase2D& operator=(TwoDimBaseType auto const& A);
+
+   ~PaddedArrayBase2D() = default;
+
+   void swap(PaddedArrayBase2D& A) noexcept;
+   void swap(PaddedArrayBase2D&& A) noexcept;
+
+   auto& resize(ImplicitInt m, ImplicitInt n, ImplicitBool preserve = true);
+   auto& resize_and_assign(TwoDimBaseType auto const& A);
+
+   ////////////////////////////////////////////////////////////////////////////////////////////////////
+   STRICT_CONSTEXPR_INLINE index_t rows() const;
+   STRICT_CONSTEXPR_INLINE index_t cols() const;
+   STRICT_CONSTEXPR_INLINE index_t size() const;
+   STRICT_CONSTEXPR_INLINE index_t leading_dim() const;
+   STRICT_NODISCARD std::pmr::memory_resource* resource() const;
+
+   STRICT_NODISCARD_CONSTEXPR static index_t padded_cols(index_t n);
+
+   STRICT_NODISCARD_INLINE value_type& un(ImplicitInt i);
+   STRICT_NODISCARD_INLINE const value_type& un(ImplicitInt i) const;
+   STRICT_NODISCARD_INLINE value_type& un(ImplicitInt i, ImplicitInt j);
+   STRICT_NODISCARD_INLINE const value_type& un(ImplicitInt i, ImplicitInt j) const;
+
+   // Packets that cross the end of a row are assembled element by element.
+   STRICT_NODISCARD_INLINE Packet<T> load_packet(ImplicitInt i) const
+      requires PacketBuiltin<T>;
+
+   STRICT_NODISCARD_INLINE value_type* row_data(ImplicitInt i) &;
+   STRICT_NODISCARD_INLINE const value_type* row_data(ImplicitInt i) const&;
+   STRICT_NODISCARD_INLINE value_type* row_data(ImplicitInt i) && = delete;
+   STRICT_NODISCARD_INLINE const value_type* row_data(ImplicitInt i) const&& = delete;
+
+   // rows() x leading_dim() elements including padding, which row(), col() and diag()
+   // are sliced from.
+   STRICT_NODISCARD Array1D<T, Aligned>& storage() &;
+   STRICT_NODISCARD const Array1D<T, Aligned>& storage() const&;
+   STRICT_NODISCARD Array1D<T, Aligned>& storage() && = delete;
+   STRICT_NODISCARD const Array1D<T, Aligned>& storage() const&& = delete;
+
+private:
+   index_t m_{};
+   index_t n_{};
+   index_t ld_{};
+   Array1D<T, Aligned> data_;
+};
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(ImplicitInt m, ImplicitInt n)
+    : m_{m.get()},
+      n_{n.get()},
+      ld_{padded_cols(n.get())},
+      data_(m.get() * padded_cols(n.get())) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(Rows m, Cols n)
+    : PaddedArrayBase2D(m.get(), n.get()) {
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                         value_type x)
+    : PaddedArrayBase2D(m, n) {
+   fill(x, *this);
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(Rows m, Cols n, Value<T> x)
+    : PaddedArrayBase2D(m.get(), n.get(), x.get()) {
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(use::List2D<builtin_type> list)
+    : PaddedArrayBase2D(list2D_row_col_sizes(list).first, list2D_row_col_sizes(list).second) {
+   ASSERT_STRICT_DEBUG(valid_list2D(list));
+   copy(list, *this);
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(PaddedArrayBase2D&& A) noexcept
+    : m_{std::exchange(A.m_, 0_sl)},
+      n_{std::exchange(A.n_, 0_sl)},
+      ld_{std::exchange(A.ld_, 0_sl)},
+      data_(std::move(A.data_)) {
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD PaddedArrayBase2D<T>::PaddedArrayBase2D(TwoDimBaseType auto const& A)
+    : PaddedArrayBase2D(A.rows(), A.cols()) {
+   copy(A, *this);
+}
+
+
+template <Builtin T>
+PaddedArrayBase2D<T>& PaddedArrayBase2D<T>::operator=(value_type x) {
+   fill(x, *this);
+   return *this;
+}
+
+
+template <Builtin T>
+PaddedArrayBase2D<T>& PaddedArrayBase2D<T>::operator=(use::List2D<builtin_type> list) {
+   // Elements are copied, so that the array keeps its memory resource.
+   const PaddedArrayBase2D tmp(list);
+   ASSERT_STRICT_DEBUG(same_size(*this, tmp));
+   return *this = tmp;
+}
+
+
+template <Builtin T>
+PaddedArrayBase2D<T>& PaddedArrayBase2D<T>::operator=(const PaddedArrayBase2D& A) {
+   ASSERT_STRICT_DEBUG(same_size(*this, A));
+   copy(A, *this);
+   return *this;
+}
+
+
+template <Builtin T>
+PaddedArrayBase2D<T>& PaddedArrayBase2D<T>::operator=(PaddedArrayBase2D&& A) noexcept {
+   NORMAL_ASSERT_STRICT_DEBUG(same_size(*this, A));
+   this->swap(A);
+   return *this;
+}
+
+
+template <Builtin T>
+PaddedArrayBase2D<T>& PaddedArrayBase2D<T>::operator=(TwoDimBaseType auto const& A) {
+   ASSERT_STRICT_DEBUG(same_size(*this, A));
+   copy(A, *this);
+   return *this;
+}
+
+
+template <Builtin T>
+void PaddedArrayBase2D<T>::swap(PaddedArrayBase2D& A) noexcept {
+   m_ = std::exchange(A.m_, m_);
+   n_ = std::exchange(A.n_, n_);
+   ld_ = std::exchange(A.ld_, ld_);
+   data_.swap(A.data_);
+}
+
+
+template <Builtin T>
+void PaddedArrayBase2D<T>::swap(PaddedArrayBase2D&& A) noexcept {
+   this->swap(A);
+}
+
+
+template <Builtin T>
+auto& PaddedArrayBase2D<T>::resize(ImplicitInt m, ImplicitInt n, ImplicitBool preserve) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+
+   if(not(m.get() == m_ && n.get() == n_)) {
+      // Allocates from the resource of the array rather than that of the calling thread.
+      const ScopedMemoryResource scope{data_.resource()};
+      PaddedArrayBase2D tmp(m, n);
+      if(preserve.get()) {
+         const index_t nc = mins(n_, n.get());
+         for(index_t i = 0_sl; i < mins(m_, m.get()); ++i) {
+            copy_contiguous(this->row_data(i), tmp.row_data(i), nc);
+         }
+      }
+      this->swap(tmp);
+   }
+   return static_cast<StrictArray2D<PaddedArrayBase2D>&>(*this);
+}
+
+
+template <Builtin T>
+auto& PaddedArrayBase2D<T>::resize_and_assign(TwoDimBaseType auto const& A) {
+   PaddedArrayBase2D tmp(A);
+   this->swap(tmp);
+   return static_cast<StrictArray2D<PaddedArrayBase2D>&>(*this);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Builtin T>
+STRICT_CONSTEXPR_INLINE index_t PaddedArrayBase2D<T>::rows() const {
+   return m_;
+}
+
+
+template <Builtin T>
+STRICT_CONSTEXPR_INLINE index_t PaddedArrayBase2D<T>::cols() const {
+   return n_;
+}
+
+
+template <Builtin T>
+STRICT_CONSTEXPR_INLINE index_t PaddedArrayBase2D<T>::size() const {
+   return m_ * n_;
+}
+
+
+template <Builtin T>
+STRICT_CONSTEXPR_INLINE index_t PaddedArrayBase2D<T>::leading_dim() const {
+   return ld_;
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD std::pmr::memory_resource* PaddedArrayBase2D<T>::resource() const {
+   return data_.resource();
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_CONSTEXPR index_t PaddedArrayBase2D<T>::padded_cols(index_t n) {
+   constexpr long int unit = long(alignment / sizeof(T)) > 0 ? long(alignment / sizeof(T)) : 1L;
+   long int ld = (n.val() + unit - 1) / unit * unit;
+   if(ld > 0 && ld * long(sizeof(T)) % 4096L == 0) {
+      ld += unit;
+   }
+   return index_t{ld};
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::un(ImplicitInt i) -> value_type& {
+   auto [r, c] = index_map_one_to_two_dim(*this, i);
+   return this->un(r, c);
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::un(ImplicitInt i) const -> const value_type& {
+   auto [r, c] = index_map_one_to_two_dim(*this, i);
+   return this->un(r, c);
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::un(ImplicitInt i, ImplicitInt j)
+    -> value_type& {
+   return data_.un(i.get() * ld_ + j.get());
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::un(ImplicitInt i, ImplicitInt j) const
+    -> const value_type& {
+   return data_.un(i.get() * ld_ + j.get());
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::load_packet(ImplicitInt i) const -> Packet<T>
+   requires PacketBuiltin<T>
+{
+   constexpr long int W = packet_size<T>();
+   auto [r, c] = index_map_one_to_two_dim(*this, i);
+   if(c + index_t{W} <= n_) {
+      return detail::load_packet<Unaligned>(this->row_data(r) + c.val());
+   }
+   Packet<T> x;
+   for(long int l = 0; l < W; ++l) {
+      x[l] = this->un(i.get() + index_t{l}).val();
+   }
+   return x;
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::row_data(ImplicitInt i) & -> value_type* {
+   return std::assume_aligned<alignment>(data_.data() + (i.get() * ld_).val());
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD_INLINE auto PaddedArrayBase2D<T>::row_data(ImplicitInt i) const&
+    -> const value_type* {
+   return std::assume_aligned<alignment>(data_.data() + (i.get() * ld_).val());
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD auto PaddedArrayBase2D<T>::storage() & -> Array1D<T, Aligned>& {
+   return data_;
+}
+
+
+template <Builtin T>
+STRICT_NODISCARD auto PaddedArrayBase2D<T>::storage() const& -> const Array1D<T, Aligned>& {
+   return data_;
+}
+
+
+}  // namespace detail
+
+
+}  // namespace spp
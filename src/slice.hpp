@@ -4,6 +4,7 @@
 #pragma once
 
 
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -230,6 +231,56 @@ template <typename T> concept NonlinearSliceType
 template <typename T> concept SliceType = LinearSliceType<T> || NonlinearSliceType<T>;
 
 
+// Same as seqN, except that the stride is known at compile time. Generated by
+// place::even, place::odd, and place::reverse for one-dimensional objects.
+template <long int S>
+class STRICT_NODISCARD StaticSeqN {
+public:
+   STRICT_NODISCARD_CONSTEXPR explicit StaticSeqN(ImplicitInt start, ImplicitInt size)
+       : start_{start.get()},
+         size_{size.get()} {
+      ASSERT_STRICT_DEBUG(start_ > -1_sl);
+      ASSERT_STRICT_DEBUG(size_ > -1_sl);
+   }
+
+   STRICT_CONSTEXPR operator seqN() const {
+      return seqN{start_, size_, S};
+   }
+
+   STRICT_CONSTEXPR index_t start() const {
+      return start_;
+   }
+
+   STRICT_CONSTEXPR index_t size() const {
+      return size_;
+   }
+
+   STRICT_CONSTEXPR static index_t stride() {
+      return index_t{S};
+   }
+
+   template <BaseType BaseT>
+   STRICT_CONSTEXPR StrictBool valid(const BaseT& A) const {
+      return seqN{*this}.valid(A);
+   }
+
+private:
+   index_t start_;
+   index_t size_;
+};
+
+
+template <typename T>
+struct IsStaticSeqN : std::false_type {};
+
+
+template <long int S>
+struct IsStaticSeqN<StaticSeqN<S>> : std::true_type {};
+
+
+template <typename T> concept StaticSeqNType = IsStaticSeqN<T>::value;
+
+
 template <typename T>
 class SliceWrapper {
 public:
@@ -319,7 +370,7 @@ public:
    }
 
    STRICT_CONSTEXPR_INLINE static auto get(OneDimBaseType auto const& A) {
-      return seqN{0, (A.size() + 1_sl) / 2_sl, 2};
+      return StaticSeqN<2>{0, (A.size() + 1_sl) / 2_sl};
    }
 
    STRICT_CONSTEXPR_INLINE static auto get_row(TwoDimBaseType auto const& A) {
@@ -339,7 +390,7 @@ public:
    }
 
    STRICT_CONSTEXPR_INLINE static auto get(OneDimBaseType auto const& A) {
-      return seqN{1, A.size() / 2_sl, 2};
+      return StaticSeqN<2>{1, A.size() / 2_sl};
    }
 
    STRICT_CONSTEXPR_INLINE static auto get_row(TwoDimBaseType auto const& A) {
@@ -359,7 +410,7 @@ public:
    }
 
    STRICT_CONSTEXPR_INLINE static auto get(OneDimBaseType auto const& A) {
-      return seqN{A.empty() ? 0_sl : A.size() - 1_sl, A.size(), -1};
+      return StaticSeqN<-1>{A.empty() ? 0_sl : A.size() - 1_sl, A.size()};
    }
 
    STRICT_CONSTEXPR_INLINE static auto get_row(TwoDimBaseType auto const& A) {
@@ -584,6 +635,37 @@ private:
 };
 
 
+template <long int S>
+class SliceArrayWrapper<StaticSeqN<S>> {
+public:
+   STRICT_CONSTEXPR explicit SliceArrayWrapper(const StaticSeqN<S>& sl) : sl_{sl} {
+   }
+
+   STRICT_CONSTEXPR_INLINE index_t size() const {
+      return sl_.size();
+   }
+
+   STRICT_CONSTEXPR StrictBool valid(BaseType auto const& A) const {
+      return sl_.valid(A);
+   }
+
+   STRICT_CONSTEXPR_INLINE ImplicitInt map(ImplicitInt i) const {
+      return sl_.start() + i.get() * index_t{S};
+   }
+
+   STRICT_CONSTEXPR_INLINE const auto& get() const& {
+      return sl_;
+   }
+
+   STRICT_CONSTEXPR_INLINE auto get() && {
+      return std::move(sl_);
+   }
+
+private:
+   StaticSeqN<S> sl_;
+};
+
+
 template <>
 class SliceArrayWrapper<std::vector<ImplicitInt>> {
 public:
@@ -621,11 +703,75 @@ public:
       return std::move(indexes_);
    }
 
+   // Indexes are read in place by gathers and scatters.
+   STRICT_INLINE const long int* index_data() const {
+      static_assert(sizeof(ImplicitInt) == sizeof(long int));
+      return reinterpret_cast<const long int*>(indexes_.data());
+   }
+
 private:
    std::vector<ImplicitInt> indexes_;
 };
 
 
+// Describes elements data[0], data[stride], ..., data[(size - 1) * stride]. data is nullptr
+// if the slice is empty or its elements are not stored at a constant stride in memory.
+template <typename Ptr>
+struct StridedData {
+   Ptr data;
+   index_t stride;
+   index_t size;
+};
+
+
+template <BaseType Base, typename Sl>
+STRICT_CONSTEXPR_INLINE auto strided_slice_data(Base& A, const SliceArrayWrapper<Sl>& slw) {
+   auto p = contiguous_data(A);
+   if constexpr(SameAs<Sl, seqN> || StaticSeqNType<Sl>) {
+      const auto& sl = slw.get();
+      return StridedData<decltype(p)>{
+          p != nullptr && sl.size() != 0_sl ? p + sl.start().val() : nullptr, sl.stride(),
+          sl.size()};
+   }
+   return StridedData<decltype(p)>{nullptr, 0_sl, slw.size()};
+}
+
+
+// Returns pointer to the first element of the slice of A if its elements are stored
+// contiguously, nullptr otherwise.
+template <BaseType Base, typename Sl>
+STRICT_CONSTEXPR_INLINE auto contiguous_slice_data(Base& A, const SliceArrayWrapper<Sl>& slw) {
+   auto sd = strided_slice_data(A, slw);
+   return sd.stride == 1_sl ? sd.data : decltype(sd.data){nullptr};
+}
+
+
+template <BaseType Base>
+STRICT_INLINE auto indexed_slice_data(Base& A,
+                                      const SliceArrayWrapper<std::vector<ImplicitInt>>& slw) {
+   auto p = contiguous_data(A);
+   return IndexedData<decltype(p)>{p, slw.index_data(), slw.size()};
+}
+
+
+// Slices by compile-time strides of arrays that are stored contiguously are read and
+// written in packets.
+template <typename Base, typename Sl> concept PacketStridedSlice
+    = PacketBuiltin<BuiltinTypeOf<Base>> && ContiguousBaseType<RemoveCVRef<Base>>
+   && (SameAs<Sl, StaticSeqN<2>> || SameAs<Sl, StaticSeqN<-1>>);
+
+
+// Slices by index vectors of arrays that are stored contiguously are gathered and
+// scattered in packets.
+template <typename Base, typename Sl> concept PacketIndexSlice
+    = PacketBuiltin<BuiltinTypeOf<Base>> && ContiguousBaseType<RemoveCVRef<Base>>
+   && SameAs<Sl, std::vector<ImplicitInt>>;
+
+
+template <typename Base, typename Sl> concept PacketSlice
+    = PacketStridedSlice<Base, Sl> || PacketIndexSlice<Base, Sl>;
+
+
 }  // namespace detail
 
 
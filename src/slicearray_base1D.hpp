@@ -5,6 +5,7 @@
 
 
 #include <utility>
+#include <vector>
 
 #include "ArrayCommon/array_common.hpp"
 #include "StrictCommon/strict_common.hpp"
@@ -39,6 +40,19 @@ public:
 
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i) const;
+   STRICT_NODISCARD_CONSTEXPR_INLINE value_type* contiguous_data();
+   STRICT_NODISCARD_CONSTEXPR_INLINE const value_type* contiguous_data() const;
+   STRICT_NODISCARD_CONSTEXPR_INLINE auto strided_data();
+   STRICT_NODISCARD_CONSTEXPR_INLINE auto strided_data() const;
+   STRICT_NODISCARD_INLINE auto indexed_data()
+      requires SameAs<Sl, std::vector<ImplicitInt>>;
+   STRICT_NODISCARD_INLINE auto indexed_data() const
+      requires SameAs<Sl, std::vector<ImplicitInt>>;
+
+   STRICT_NODISCARD_INLINE Packet<builtin_type> load_packet(ImplicitInt i) const
+      requires PacketSlice<Base, Sl>;
+   STRICT_INLINE void store_packet(ImplicitInt i, Packet<builtin_type> x)
+      requires PacketSlice<Base, Sl>;
    STRICT_NODISCARD_CONSTEXPR const auto& get_slice() const&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() &&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() const&&;
@@ -107,6 +121,73 @@ STRICT_NODISCARD_CONSTEXPR_INLINE auto SliceArrayBase1D<Base, Sl>::un(ImplicitIn
 }
 
 
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto SliceArrayBase1D<Base, Sl>::contiguous_data()
+    -> value_type* {
+   return contiguous_slice_data(A_, slw_);
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto SliceArrayBase1D<Base, Sl>::contiguous_data() const
+    -> const value_type* {
+   return contiguous_slice_data(A_, slw_);
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto SliceArrayBase1D<Base, Sl>::strided_data() {
+   return strided_slice_data(A_, slw_);
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto SliceArrayBase1D<Base, Sl>::strided_data() const {
+   return strided_slice_data(A_, slw_);
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE auto SliceArrayBase1D<Base, Sl>::indexed_data()
+   requires SameAs<Sl, std::vector<ImplicitInt>>
+{
+   return indexed_slice_data(A_, slw_);
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE auto SliceArrayBase1D<Base, Sl>::indexed_data() const
+   requires SameAs<Sl, std::vector<ImplicitInt>>
+{
+   return indexed_slice_data(A_, slw_);
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE auto SliceArrayBase1D<Base, Sl>::load_packet(ImplicitInt i) const
+    -> Packet<builtin_type>
+   requires PacketSlice<Base, Sl>
+{
+   if constexpr(PacketIndexSlice<Base, Sl>) {
+      return gather_packet(A_.data(), slw_.index_data() + i.get().val());
+   } else {
+      return load_packet_strided<Sl::stride().val()>(A_.data() + slw_.map(i).get().val());
+   }
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_INLINE void SliceArrayBase1D<Base, Sl>::store_packet(ImplicitInt i, Packet<builtin_type> x)
+   requires PacketSlice<Base, Sl>
+{
+   if constexpr(PacketIndexSlice<Base, Sl>) {
+      scatter_packet(A_.data(), slw_.index_data() + i.get().val(), x);
+   } else {
+      store_packet_strided<Sl::stride().val()>(A_.data() + slw_.map(i).get().val(), x);
+   }
+}
+
+
 template <NonConstBaseType Base, typename Sl>
 STRICT_NODISCARD_CONSTEXPR const auto& SliceArrayBase1D<Base, Sl>::get_slice() const& {
    return slw_.get();
@@ -146,6 +227,14 @@ public:
    STRICT_CONSTEXPR ~ConstSliceArrayBase1D() = default;
 
    STRICT_NODISCARD_CONSTEXPR_INLINE decltype(auto) un(ImplicitInt i) const;
+   STRICT_NODISCARD_CONSTEXPR_INLINE const value_type* contiguous_data() const;
+   STRICT_NODISCARD_CONSTEXPR_INLINE auto strided_data() const;
+   STRICT_NODISCARD_INLINE auto indexed_data() const
+      requires SameAs<Sl, std::vector<ImplicitInt>>;
+
+   STRICT_NODISCARD_INLINE Packet<builtin_type> load_packet(ImplicitInt i) const
+      requires PacketSlice<Base, Sl>;
+
    STRICT_NODISCARD_CONSTEXPR const auto& get_slice() const&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() &&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() const&&;
@@ -174,6 +263,40 @@ STRICT_NODISCARD_CONSTEXPR_INLINE decltype(auto) ConstSliceArrayBase1D<Base, Sl>
 }
 
 
+template <BaseType Base, typename Sl>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ConstSliceArrayBase1D<Base, Sl>::contiguous_data() const
+    -> const value_type* {
+   return contiguous_slice_data(A_, slw_);
+}
+
+
+template <BaseType Base, typename Sl>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ConstSliceArrayBase1D<Base, Sl>::strided_data() const {
+   return strided_slice_data(A_, slw_);
+}
+
+
+template <BaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE auto ConstSliceArrayBase1D<Base, Sl>::indexed_data() const
+   requires SameAs<Sl, std::vector<ImplicitInt>>
+{
+   return indexed_slice_data(A_, slw_);
+}
+
+
+template <BaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE auto ConstSliceArrayBase1D<Base, Sl>::load_packet(ImplicitInt i) const
+    -> Packet<builtin_type>
+   requires PacketSlice<Base, Sl>
+{
+   if constexpr(PacketIndexSlice<Base, Sl>) {
+      return gather_packet(A_.data(), slw_.index_data() + i.get().val());
+   } else {
+      return load_packet_strided<Sl::stride().val()>(A_.data() + slw_.map(i).get().val());
+   }
+}
+
+
 template <BaseType Base, typename Sl>
 STRICT_NODISCARD_CONSTEXPR const auto& ConstSliceArrayBase1D<Base, Sl>::get_slice() const& {
    return slw_.get();
@@ -0,0 +1,344 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <future>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "array_IO.hpp"
+#include "array_ops.hpp"
+#include "array_stable_ops.hpp"
+#include "attach1D.hpp"
+#include "binary_IO.hpp"
+#include "npy_IO.hpp"
+
+
+namespace spp {
+
+
+enum class FileFormat { Binary, Npy, Text };
+
+
+namespace detail {
+
+
+inline constexpr std::size_t stream_block_bytes = std::size_t(1) << 23;
+
+
+}  // namespace detail
+
+
+// Reads the elements of a file in blocks of fixed size, so that files larger than memory
+// can be processed with constant memory. Elements of binary and npy files are read in the
+// order they are stored, those of text files in the order they appear. While the current
+// block is processed, the next one is read into a second buffer by another thread.
+template <detail::CompatibleBuiltin T>
+class STRICT_NODISCARD FileStream {
+public:
+   explicit FileStream(const std::string& file_path, FileFormat format,
+                       ImplicitInt block_size = default_block_size())
+       : format_{format},
+         block_size_{checked_block_size(block_size.get())},
+         file_{detail::open_binary(file_path, "rb")},
+         buffers_{Array1D<T, Aligned>(block_size_, uninitialized),
+                  Array1D<T, Aligned>(block_size_, uninitialized)} {
+      if(format_ == FileFormat::Binary) {
+         const BinaryHeader h = detail::read_binary_header(file_.get());
+         ASSERT_STRICT_ALWAYS_MSG(h.rank == 1 || h.rank == 2,
+                                  "Dimension of the binary file does not match.\n");
+         detail::validate_binary_header<T>(h, h.rank);
+         swap_ = bool(h.little_endian) != detail::native_little_endian;
+         remaining_ = index_t{h.dims[0]} * index_t{h.dims[1]};
+      } else if(format_ == FileFormat::Npy) {
+         const detail::NpyHeader h = detail::read_npy_header(file_.get());
+         swap_ = detail::validate_npy_header<T>(h, h.shape.size());
+         remaining_ = 1_sl;
+         for(auto d : h.shape) {
+            remaining_ *= index_t{d};
+         }
+      } else {
+         text_.resize(std::max(std::size_t(block_size_.val()) * sizeof(T), std::size_t(64)));
+      }
+      this->read_async();
+   }
+
+   FileStream(const FileStream&) = delete;
+   FileStream& operator=(const FileStream&) = delete;
+
+   static index_t default_block_size() {
+      return to_index_t(detail::stream_block_bytes / sizeof(T));
+   }
+
+   index_t block_size() const {
+      return block_size_;
+   }
+
+   // Returns the next block of at most block_size() elements, which is empty once all
+   // elements have been read. The block remains valid until the next call.
+   STRICT_NODISCARD auto next() {
+      index_t count{};
+      const int k = filling_;
+      if(pending_.valid()) {
+         count = pending_.get();
+         filling_ ^= 1;
+         // Only the last block is not full.
+         if(count == block_size_) {
+            this->read_async();
+         }
+      }
+      const T* p = reinterpret_cast<const T*>(buffers_[k].data());
+      return attach1D(p, count);
+   }
+
+private:
+   FileFormat format_;
+   index_t block_size_;
+   detail::FilePtr file_;
+   bool swap_{};
+   index_t remaining_{};
+
+   std::vector<char> text_;
+   std::size_t text_first_{};
+   std::size_t text_last_{};
+   bool text_eof_{};
+
+   Array1D<T, Aligned> buffers_[2];
+   int filling_{};
+   // Declared last, so that the destructor waits for the pending read before the file and
+   // buffers are released.
+   std::future<index_t> pending_;
+
+   // Called from the member initializer list, before the buffers are allocated.
+   static index_t checked_block_size(index_t block_size) {
+      ASSERT_STRICT_ALWAYS(block_size > 0_sl);
+      return block_size;
+   }
+
+   void read_async() {
+      pending_ = std::async(std::launch::async, [this, p = buffers_[filling_].data()] {
+         auto* x = reinterpret_cast<T*>(p);
+         return format_ == FileFormat::Text ? this->read_text(x) : this->read_binary(x);
+      });
+   }
+
+   index_t read_binary(T* x) {
+      const index_t count = mins(block_size_, remaining_);
+      detail::read_bytes(file_.get(), x, std::size_t(count.val()) * sizeof(T));
+      if(swap_) {
+         detail::byteswap_bytes(x, sizeof(T), std::size_t(count.val()));
+      }
+      remaining_ -= count;
+      return count;
+   }
+
+   index_t read_text(T* x) {
+      index_t count{};
+      while(count < block_size_) {
+         const char* last = text_.data() + text_last_;
+         const char* first = detail::skip_text_spaces(text_.data() + text_first_, last);
+         const char* token_end = detail::skip_text_token(first, last);
+         text_first_ = std::size_t(first - text_.data());
+         // The token may continue in the part of the file that has not been read yet.
+         if(token_end == last && !text_eof_) {
+            this->refill_text();
+            continue;
+         }
+         if(first == last) {
+            break;
+         }
+         ASSERT_STRICT_ALWAYS_MSG(detail::parse_text_number(first, token_end, x[count.val()]),
+                                  "Invalid input.\n");
+         ++count;
+         text_first_ = std::size_t(token_end - text_.data());
+      }
+      return count;
+   }
+
+   // Moves the unparsed text to the front of the buffer and fills the rest from the file.
+   // The buffer grows if a single token does not fit in it.
+   void refill_text() {
+      const std::size_t tail = text_last_ - text_first_;
+      std::copy(text_.begin() + long(text_first_), text_.begin() + long(text_last_),
+                text_.begin());
+      if(tail == text_.size()) {
+         text_.resize(2 * text_.size());
+      }
+      const std::size_t bytes = text_.size() - tail;
+      const std::size_t nread = std::fread(text_.data() + tail, 1, bytes, file_.get());
+      ASSERT_STRICT_ALWAYS_MSG(!std::ferror(file_.get()), "Cannot read the file.\n");
+      text_first_ = 0;
+      text_last_ = tail + nread;
+      text_eof_ = nread < bytes;
+   }
+};
+
+
+// Reductions over all elements of the stream. They read the stream to the end, except
+// any_of and all_of, which stop once the result is known.
+template <Real T>
+Strict<T> sum(FileStream<T>& stream, Strict<T> empty_default = {});
+
+
+template <Floating T>
+Strict<T> stable_sum(FileStream<T>& stream, Strict<T> empty_default = {});
+
+
+template <Real T>
+Strict<T> min(FileStream<T>& stream, Strict<T> empty_default = {});
+
+
+template <Real T>
+Strict<T> max(FileStream<T>& stream, Strict<T> empty_default = {});
+
+
+template <Real T>
+Strict<T> dot_prod(FileStream<T>& stream1, FileStream<T>& stream2,
+                   Strict<T> empty_default = {});
+
+
+template <Floating T>
+Strict<T> norm2(FileStream<T>& stream, Strict<T> empty_default = {});
+
+
+template <Builtin T, typename F>
+StrictBool any_of(FileStream<T>& stream, F f, StrictBool empty_default = false_sb);
+
+
+template <Builtin T, typename F>
+StrictBool all_of(FileStream<T>& stream, F f, StrictBool empty_default = true_sb);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+
+// Calls f on the blocks of the stream until f returns false. Returns false if the stream
+// has no elements.
+template <typename T, typename F>
+bool for_each_block(FileStream<T>& stream, F f) {
+   bool nonempty = false;
+   while(true) {
+      const auto block = stream.next();
+      if(block.empty()) {
+         return nonempty;
+      }
+      nonempty = true;
+      if(!f(block)) {
+         return true;
+      }
+   }
+}
+
+
+}  // namespace detail
+
+
+template <Real T>
+Strict<T> sum(FileStream<T>& stream, Strict<T> empty_default) {
+   Strict<T> s{};
+   const bool nonempty = detail::for_each_block(stream, [&s](const auto& block) {
+      s += sum(block);
+      return true;
+   });
+   return nonempty ? s : empty_default;
+}
+
+
+// The compensation is carried over from one block to the next, so the result is the same as
+// that of stable_sum of all elements at once.
+template <Floating T>
+Strict<T> stable_sum(FileStream<T>& stream, Strict<T> empty_default) {
+   T s{};
+   T c{};
+   const bool nonempty = detail::for_each_block(stream, [&s, &c](const auto& block) {
+      detail::stable_sum_add(block, s, c);
+      return true;
+   });
+   return nonempty ? Strict<T>{s + c} : empty_default;
+}
+
+
+template <Real T>
+Strict<T> min(FileStream<T>& stream, Strict<T> empty_default) {
+   std::optional<Strict<T>> r;
+   detail::for_each_block(stream, [&r](const auto& block) {
+      r = r ? mins(*r, min(block)) : min(block);
+      return true;
+   });
+   return r.value_or(empty_default);
+}
+
+
+template <Real T>
+Strict<T> max(FileStream<T>& stream, Strict<T> empty_default) {
+   std::optional<Strict<T>> r;
+   detail::for_each_block(stream, [&r](const auto& block) {
+      r = r ? maxs(*r, max(block)) : max(block);
+      return true;
+   });
+   return r.value_or(empty_default);
+}
+
+
+// Blocks of both streams are read at the same time, so they must have the same block size.
+template <Real T>
+Strict<T> dot_prod(FileStream<T>& stream1, FileStream<T>& stream2, Strict<T> empty_default) {
+   ASSERT_STRICT_ALWAYS_MSG(stream1.block_size() == stream2.block_size(),
+                            "Streams have different block sizes.\n");
+   Strict<T> s{};
+   const bool nonempty = detail::for_each_block(stream1, [&s, &stream2](const auto& block1) {
+      const auto block2 = stream2.next();
+      ASSERT_STRICT_ALWAYS_MSG(block1.size() == block2.size(),
+                               "Streams have different sizes.\n");
+      s += dot_prod(block1, block2);
+      return true;
+   });
+   ASSERT_STRICT_ALWAYS_MSG(stream2.next().empty(), "Streams have different sizes.\n");
+   return nonempty ? s : empty_default;
+}
+
+
+template <Floating T>
+Strict<T> norm2(FileStream<T>& stream, Strict<T> empty_default) {
+   Strict<T> s{};
+   const bool nonempty = detail::for_each_block(stream, [&s](const auto& block) {
+      s += dot_prod(block, block);
+      return true;
+   });
+   return nonempty ? sqrts(s) : empty_default;
+}
+
+
+template <Builtin T, typename F>
+StrictBool any_of(FileStream<T>& stream, F f, StrictBool empty_default) {
+   StrictBool r = false_sb;
+   const bool nonempty = detail::for_each_block(stream, [&r, &f](const auto& block) {
+      r = any_of(block, f);
+      return !r.val();
+   });
+   return nonempty ? r : empty_default;
+}
+
+
+template <Builtin T, typename F>
+StrictBool all_of(FileStream<T>& stream, F f, StrictBool empty_default) {
+   StrictBool r = true_sb;
+   const bool nonempty = detail::for_each_block(stream, [&r, &f](const auto& block) {
+      r = all_of(block, f);
+      return r.val();
+   });
+   return nonempty ? r : empty_default;
+}
+
+
+}  // namespace spp
@@ -13,14 +13,21 @@
 #include "Expr/expr.hpp"
 #include "StrictCommon/strict_common.hpp"
 #include "Util/util.hpp"
+#include "archive_IO.hpp"
 #include "array_IO.hpp"
 #include "array_ops.hpp"
 #include "array_stable_ops.hpp"
+#include "async_IO.hpp"
 #include "attach1D.hpp"
 #include "attach2D.hpp"
+#include "binary_IO.hpp"
 #include "concepts.hpp"
 #include "derived1D.hpp"
 #include "derived2D.hpp"
+#include "mapped_file.hpp"
+#include "matmul.hpp"
+#include "npy_IO.hpp"
+#include "stream_ops.hpp"
 
 
 #endif
@@ -1,6 +1,9 @@
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <memory_resource>
 #include <utility>
+#include <vector>
 
 #include "test.hpp"
 
@@ -37,6 +40,30 @@ void run_constr_size_value(ImplicitInt n) {
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+void run_constr_uninitialized(ImplicitInt n) {
+   Array1D<T, AF> A1(n, uninitialized);
+   ASSERT(A1.size() == n.get());
+   A1 = One<T>;
+   ASSERT(all_of(A1, One<T>));
+
+   Array1D<T, AF> A2(n, first_touch);
+   ASSERT(A2 == Array1D<T>(n));
+
+   Array2D<T, AF> A3(n, 3, uninitialized);
+   ASSERT(A3.rows() == n.get() && A3.cols() == 3_sl);
+   A3 = One<T>;
+   ASSERT(all_of(A3, One<T>));
+
+   Array2D<T, AF> A4(n, 3, first_touch);
+   ASSERT(A4 == Array2D<T>(n, 3));
+
+   const Array1D<T, AF> A5(0, uninitialized);
+   const Array1D<T, AF> A6(0, first_touch);
+   ASSERT(A5.empty() && A6.empty());
+}
+
+
 template <Builtin T>
 void run_constr_list() {
    auto x0 = Zero<T>;
@@ -318,6 +345,36 @@ void run_insert_array_back(auto X) {
 }
 
 
+// Inserting the array or a slice of it into itself.
+void run_insert_self(auto X, Pos pos) {
+   using namespace place;
+   const auto Y = X;
+   const index_t n = X.size();
+
+   X.insert(pos, X);
+   ASSERT(X == merge(Y(firstN(pos.get())), Y, Y(lastN(n - pos.get()))));
+
+   X.resize_and_assign(Y);
+   X.insert(pos, X(lastN(10)));
+   ASSERT(X == merge(Y(firstN(pos.get())), Y(lastN(10)), Y(lastN(n - pos.get()))));
+}
+
+
+// Removing and inserting within the capacity keeps the buffer.
+void run_remove_insert_in_place(auto X) {
+   X.remove(Pos{10}, Count{25});
+   X.remove({0, 2, 5, 40, 74});
+   const auto* p = X.data();
+   const auto Y = X;
+
+   X.insert(Pos{30}, Y(place::firstN(30)));
+   ASSERT(X.data() == p);
+   X.remove(Pos{30}, Count{30});
+   ASSERT(X.data() == p);
+   ASSERT(X == Y);
+}
+
+
 template <Builtin T>
 void run_insert_fail() {
    Array1D<T> A(10);
@@ -327,6 +384,186 @@ void run_insert_fail() {
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+void run_capacity() {
+   constexpr index_t n = 1000_sl;
+   const Array1D<T> B = random<T>(n);
+   Array1D<T, AF> A;
+   index_t nallocations{};
+   for(index_t i = 0_sl; i < B.size(); ++i) {
+      const auto cap = A.capacity();
+      A.insert_back(B[i]);
+      if(A.capacity() != cap) {
+         ++nallocations;
+      }
+      ASSERT(A.capacity() >= A.size());
+   }
+   ASSERT(A == B);
+   // Capacity at least doubles with every allocation.
+   ASSERT(nallocations <= 11_sl);
+   if constexpr(AF == Aligned) {
+      const auto alignment = std::uintptr_t(Array1D<T, AF>::alignment);
+      ASSERT(reinterpret_cast<std::uintptr_t>(A.data()) % alignment == 0);
+   }
+
+   A.shrink_to_fit();
+   ASSERT(A.capacity() == A.size() && A == B);
+
+   A.reserve(2_sl * n);
+   const auto* p = A.data();
+   A.insert_back(A);
+   ASSERT(A.data() == p);
+   ASSERT(A == merge(B, B));
+
+   A.resize(n / 2_sl);
+   ASSERT(A.capacity() == 2_sl * n);
+   A.resize(n);
+   ASSERT(A.data() == p);
+   ASSERT(A(place::firstN(n / 2_sl)) == B(place::firstN(n / 2_sl)));
+   ASSERT(A(place::lastN(n - n / 2_sl)) == Array1D<T>(n - n / 2_sl));
+
+   // Elements are zero-initialized if they are not preserved, also within the capacity.
+   A.resize(n / 2_sl, false);
+   A.resize(n, false);
+   ASSERT(A.data() == p);
+   ASSERT(A == Array1D<T>(n));
+   A.resize(n / 2_sl);
+   A = B(place::firstN(n / 2_sl));
+   A.resize(n, false);
+   ASSERT(A == Array1D<T>(n));
+
+   A.resize(0);
+   A.shrink_to_fit();
+   ASSERT(A.capacity() == 0_sl && A.data() == nullptr);
+}
+
+
+// Counts bytes allocated from and returned to the upstream resource.
+class CountingResource : public std::pmr::memory_resource {
+public:
+   std::size_t allocated{};
+   std::size_t deallocated{};
+
+private:
+   void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+      allocated += bytes;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+   }
+
+   void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+      deallocated += bytes;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+   }
+
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+   }
+};
+
+
+template <Real T, AlignmentFlag AF>
+void run_memory_resource() {
+   constexpr index_t n = 100_sl;
+   const Array1D<T> B = random<T>(n);
+   CountingResource resource;
+   {
+      Array1D<T, AF> A;
+      Array2D<T, AF> C;
+      {
+         ScopedMemoryResource scope(&resource);
+         ASSERT(memory_resource() == &resource);
+         A.resize_and_assign(Array1D<T, AF>(n));
+         C.resize_and_assign(Array2D<T, AF>(2, n));
+      }
+      ASSERT(memory_resource() == nullptr);
+      ASSERT(A.resource() == &resource && C.resource() == &resource);
+      ASSERT(all_zeros(A) && all_zeros(C));
+      if constexpr(AF == Aligned) {
+         const auto alignment = std::uintptr_t(Array1D<T, AF>::alignment);
+         ASSERT(reinterpret_cast<std::uintptr_t>(A.data()) % alignment == 0);
+      }
+
+      // Growing outside of the scope keeps allocating from the resource of the array.
+      const auto allocated = resource.allocated;
+      A = B;
+      A.insert_back(B);
+      A.remove(Pos{0}, Count{n});
+      C.insert_row_back(B);
+      ASSERT(resource.allocated > allocated);
+      ASSERT(A == B && C.rows() == 3_sl);
+      C.resize(4, n);
+      C.resize(5, n, false);
+      ASSERT(C.resource() == &resource && C.rows() == 5_sl && all_zeros(C));
+
+      const Array1D<T, AF> D = A;
+      ASSERT(D.resource() == nullptr);
+      Array1D<T, AF> E = std::move(A);
+      ASSERT(E.resource() == &resource && A.resource() == nullptr);
+   }
+   ASSERT(resource.allocated == resource.deallocated);
+
+   // Default constructed arrays allocate from the scope they are constructed in when they
+   // are resized, arrays constructed outside of it do not.
+   {
+      Array2D<T, AF> C(2, n);
+      ScopedMemoryResource scope(&resource);
+      Array1D<T, AF> A;
+      Array2D<T, AF> D;
+      A.resize(n);
+      D.resize(2, n);
+      C.resize(3, n);
+      ASSERT(A.resource() == &resource && D.resource() == &resource);
+      ASSERT(C.resource() == nullptr);
+   }
+   ASSERT(resource.allocated == resource.deallocated);
+
+   std::pmr::monotonic_buffer_resource buffer;
+   ScopedMemoryResource scope(&buffer);
+   Array1D<T> A = B + B;
+   ASSERT(A.resource() == &buffer && A == Array1D<T>(B + B));
+}
+
+
+#ifdef __linux__
+template <Real T, AlignmentFlag AF>
+void run_page_resource(PagePolicy pages, NumaPolicy numa) {
+   // 600000 elements take more than one huge page for every type.
+   constexpr index_t n = 600000_sl;
+   const Array1D<T> B = random<T>(n);
+   CountingResource upstream;
+   PageResource resource(pages, numa, PageResource::huge_page_size, &upstream);
+   {
+      ScopedMemoryResource scope(&resource);
+      Array1D<T, AF> A(n, first_touch);
+      Array2D<T, AF> C(2, n, uninitialized);
+      Array1D<T, AF> small(10);
+      ASSERT(all_zeros(A));
+      ASSERT(upstream.allocated == 10 * sizeof(Strict<T>));
+
+      const auto alignment = pages == PagePolicy::Default ? std::uintptr_t(4096)
+                                                          : PageResource::huge_page_size;
+      ASSERT(reinterpret_cast<std::uintptr_t>(A.data()) % alignment == 0);
+
+      A = B;
+      C.row(0) = B;
+      C.row(1) = B + B;
+      A.insert_back(B);
+      ASSERT(A == merge(B, B));
+      ASSERT(C.row(1) == B + B);
+   }
+   ASSERT(upstream.allocated == upstream.deallocated);
+}
+#endif
+
+
+template <Builtin T>
+void run_capacity_fail() {
+   Array1D<T> A;
+   REQUIRE_THROW(A.reserve(-1));
+   REQUIRE_NOT_THROW(A.reserve(0));
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void run_resize_and_assign_strong() {
    Array1D<int> A1{2_si, 2_si, 2_si};
@@ -345,6 +582,8 @@ void array_constructor() {
    run_constr_default<T>();
    run_constr_size<T>(n);
    run_constr_size_value<T>(n);
+   run_constr_uninitialized<T, Aligned>(n);
+   run_constr_uninitialized<T, Unaligned>(n);
    run_constr_list<T>();
    run_constr_iterator<T>(n);
    run_constr_copy<T>(n);
@@ -382,6 +621,10 @@ void array_resize() {
    run_swap_rvalue(A1);
    run_resize_assign(A1, A2);
    run_resize_assign_move(A1, A2);
+
+   run_capacity<T, Aligned>();
+   run_capacity<T, Unaligned>();
+   run_capacity_fail<T>();
 }
 
 
@@ -423,10 +666,30 @@ void array_insert() {
    run_insert_array_front(A);
    run_insert_array_back(A);
 
+   run_insert_self(A, Pos{0});
+   run_insert_self(A, Pos{10});
+   run_insert_self(A, Pos{100});
+   run_remove_insert_in_place(A);
+
    run_insert_fail<T>();
 }
 
 
+template <Real T>
+void array_memory_resource() {
+   run_memory_resource<T, Aligned>();
+   run_memory_resource<T, Unaligned>();
+#ifdef __linux__
+   for(auto pages : {PagePolicy::Default, PagePolicy::TransparentHuge, PagePolicy::ExplicitHuge}) {
+      for(auto numa : {NumaPolicy::Default, NumaPolicy::Interleave, NumaPolicy::Local}) {
+         run_page_resource<T, Aligned>(pages, numa);
+         run_page_resource<T, Unaligned>(pages, numa);
+      }
+   }
+#endif
+}
+
+
 template <Real T>
 void array_data() {
    constexpr index_t n = 100_sl;
@@ -447,6 +710,270 @@ void array_data() {
 }
 
 
+template <AlignmentFlag AF, Floating T>
+void run_expression(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   const Array1D<T, AF> B = random<T>(n, One<T>, Strict<T>{T(2)});
+   Array1D<T, AF> C(n);
+
+   C = -A + B * A - B / A + Strict<T>{T(3)};
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      ASSERT(C[i] == -A[i] + B[i] * A[i] - B[i] / A[i] + Strict<T>{T(3)});
+   }
+
+   C = Strict<T>{T(5)};
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      ASSERT(C[i] == Strict<T>{T(5)});
+   }
+}
+
+
+template <Real T>
+void run_contiguous(ImplicitInt n) {
+   static_assert(detail::ContiguousBaseType<Array1D<T>>);
+   static_assert(detail::ContiguousBaseType<FixedArray1D<T, 5>>);
+   static_assert(detail::ContiguousBaseType<Array2D<T>>);
+
+   Array1D<T> A(n);
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      A[i] = Strict<T>{T(i.val() % 3)};
+   }
+
+   auto S = A(seqN(1, n.get() - 2_sl));
+   ASSERT(detail::contiguous_data(S) == A.data() + 1);
+   auto S2 = A(seqN(0, n.get() / 2_sl, 2));
+   ASSERT(detail::contiguous_data(S2) == nullptr);
+
+   Array1D<T> B = S;
+   ASSERT(B.size() == n.get() - 2_sl);
+   for(index_t i = 0_sl; i < B.size(); ++i) {
+      ASSERT(B[i] == A[i + 1_sl]);
+   }
+
+   Array1D<T> C(n.get() - 2_sl);
+   C(seqN(0, C.size())) = S;
+   ASSERT(C == B);
+
+   Array2D<T> M(3, n.get() - 2_sl);
+   M.row(1) = S;
+   auto R = M.row(1);
+   ASSERT(detail::contiguous_data(R) == M.data() + M.cols().val());
+   ASSERT(R == B);
+
+   T* ptr = A.blas_data();
+   auto P = attach1D(ptr, n);
+   ASSERT(detail::contiguous_data(P) == A.data());
+}
+
+
+template <AlignmentFlag AF, Floating T>
+void run_strided_expression(ImplicitInt n) {
+   using namespace place;
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   const Array1D<T, AF> B = random<T>(n, One<T>, Strict<T>{T(2)});
+   Array1D<T, AF> C(n, Zero<T>);
+
+   C(even) = A(even) * B(even) + Strict<T>{T(3)};
+   C(odd) = A(odd) - B(odd);
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      if(i % 2_sl == 0_sl) {
+         ASSERT(C[i] == A[i] * B[i] + Strict<T>{T(3)});
+      } else {
+         ASSERT(C[i] == A[i] - B[i]);
+      }
+   }
+
+   C(reverse) = A + B(reverse);
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      ASSERT(C[n.get() - 1_sl - i] == A[i] + B[n.get() - 1_sl - i]);
+   }
+
+   const auto S = C(even);
+   ASSERT(S.strided_data().stride == 2_sl);
+   ASSERT(S.strided_data().size == (n.get() + 1_sl) / 2_sl);
+}
+
+
+template <AlignmentFlag AF, Floating T>
+void run_index_expression(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   const Array1D<T, AF> B = random<T>(n, One<T>, Strict<T>{T(2)});
+   Array1D<T, AF> C(n, Zero<T>);
+   Array1D<T, AF> R(n, Zero<T>);
+
+   // Unordered, with repeated indexes.
+   std::vector<ImplicitInt> idx;
+   for(index_t k = 0_sl; k < n.get(); ++k) {
+      idx.emplace_back((7_sl * k + 3_sl) % n.get());
+      idx.emplace_back(k / 2_sl);
+   }
+   C(idx) = A(idx) * B(idx) + Strict<T>{T(3)};
+   for(auto i : idx) {
+      R[i.get()] = A[i.get()] * B[i.get()] + Strict<T>{T(3)};
+   }
+   ASSERT(C == R);
+
+   Array1D<T, AF> D = B(idx);
+   for(std::size_t k = 0; k < idx.size(); ++k) {
+      ASSERT(D[to_index_t(k)] == B[idx[k].get()]);
+   }
+
+   // Strictly increasing, with long runs of consecutive indexes.
+   std::vector<ImplicitInt> runs;
+   for(index_t k = 0_sl; k < n.get(); ++k) {
+      if(k % 40_sl < 30_sl) {
+         runs.emplace_back(k);
+      }
+   }
+   C(runs) += B(runs);
+   C(runs) *= A(runs);
+   for(auto i : runs) {
+      R[i.get()] = (R[i.get()] + B[i.get()]) * A[i.get()];
+   }
+   ASSERT(C == R);
+
+   Array1D<T, AF> E = A(runs);
+   ASSERT(E == A(runs));
+   C(runs) = E;
+   C(place::complement(runs)) = Strict<T>{T(5)};
+   for(index_t k = 0_sl; k < n.get(); ++k) {
+      ASSERT(C[k] == (k % 40_sl < 30_sl ? A[k] : Strict<T>{T(5)}));
+   }
+
+   auto S = C(runs);
+   const auto d = S.indexed_data();
+   ASSERT(d.data == C.data());
+   ASSERT(d.size == to_index_t(runs.size()));
+   ASSERT(d.index[0] == 0);
+}
+
+
+template <AlignmentFlag AF, Floating T>
+void run_transpose_expression(ImplicitInt m, ImplicitInt n) {
+   const Array2D<T, AF> A = random<T>(m, n, One<T>, Strict<T>{T(2)});
+   const Array2D<T, AF> B = random<T>(n, m, One<T>, Strict<T>{T(2)});
+   Array2D<T, AF> C(n, m);
+
+   C = transpose(A);
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      for(index_t j = 0_sl; j < m.get(); ++j) {
+         ASSERT(C(i, j) == A(j, i));
+      }
+   }
+
+   C = B - Strict<T>{T(2)} * transpose(A) + const2D<T>(n, m, Strict<T>{T(3)});
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      for(index_t j = 0_sl; j < m.get(); ++j) {
+         ASSERT(C(i, j) == B(i, j) - Strict<T>{T(2)} * A(j, i) + Strict<T>{T(3)});
+      }
+   }
+
+   Array2D<T, AF> D = transpose(transpose(A) + B);
+   ASSERT(D == A + transpose(B));
+
+   // Slices cannot be read in tiles.
+   auto S = A(seq(0, m.get() - 1_sl), seq(0, n.get() - 1_sl));
+   C = transpose(S);
+   ASSERT(C == transpose(A));
+}
+
+
+// Packet and element by element evaluation of reductions must agree bitwise.
+template <AlignmentFlag AF, Floating T>
+void run_reduction(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, -One<T>, One<T>);
+   const Array1D<T, AF> B = random<T>(n, -One<T>, One<T>);
+   ASSERT(sum(A) == sum(A.view1D()));
+   ASSERT(prod(A) == prod(A.view1D()));
+   ASSERT(min(A) == min(A.view1D()));
+   ASSERT(max(A) == max(A.view1D()));
+   ASSERT(dot_prod(A, B) == dot_prod(A.view1D(), B.view1D()));
+   ASSERT(norm1(A) == norm1(A.view1D()));
+   ASSERT(norm_inf(A) == norm_inf(A.view1D()));
+
+   if(!A.empty()) {
+      auto min_elem = A[0], max_elem = A[0];
+      for(index_t i = 1_sl; i < n.get(); ++i) {
+         min_elem = mins(min_elem, A[i]);
+         max_elem = maxs(max_elem, A[i]);
+      }
+      ASSERT(min(A) == min_elem);
+      ASSERT(max(A) == max_elem);
+   }
+}
+
+
+template <Real T>
+void array_contiguous() {
+   run_contiguous<T>(3);
+   run_contiguous<T>(10);
+   run_contiguous<T>(1001);
+}
+
+
+template <Floating T>
+void array_expression() {
+   for(index_t n = 0_sl; n < 70_sl; ++n) {
+      run_expression<Aligned, T>(n);
+      run_expression<Unaligned, T>(n);
+   }
+   run_expression<Aligned, T>(1000);
+   run_expression<Unaligned, T>(1001);
+}
+
+
+template <Floating T>
+void array_strided_expression() {
+   for(index_t n = 0_sl; n < 70_sl; ++n) {
+      run_strided_expression<Aligned, T>(n);
+      run_strided_expression<Unaligned, T>(n);
+   }
+   run_strided_expression<Aligned, T>(1000);
+   run_strided_expression<Unaligned, T>(1001);
+}
+
+
+template <Floating T>
+void array_index_expression() {
+   for(index_t n = 1_sl; n < 70_sl; ++n) {
+      run_index_expression<Aligned, T>(n);
+      run_index_expression<Unaligned, T>(n);
+   }
+   run_index_expression<Aligned, T>(1000);
+   run_index_expression<Unaligned, T>(1001);
+}
+
+
+template <Floating T>
+void array_transpose_expression() {
+   for(index_t m = 1_sl; m < 40_sl; m += 3_sl) {
+      for(index_t n = 1_sl; n < 40_sl; n += 2_sl) {
+         run_transpose_expression<Aligned, T>(m, n);
+         run_transpose_expression<Unaligned, T>(m, n);
+      }
+   }
+   run_transpose_expression<Aligned, T>(200, 131);
+   run_transpose_expression<Unaligned, T>(67, 301);
+}
+
+
+template <Floating T>
+void array_reduction() {
+   for(index_t n = 0_sl; n < 70_sl; ++n) {
+      run_reduction<Aligned, T>(n);
+      run_reduction<Unaligned, T>(n);
+   }
+   run_reduction<Aligned, T>(20000);
+   run_reduction<Unaligned, T>(20001);
+
+   Array1D<long int> A(20001);
+   for(index_t i = 0_sl; i < A.size(); ++i) {
+      A[i] = i;
+   }
+   ASSERT(sum(A) == 20000_sl * 20001_sl / 2_sl);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void array_strong_guarantee() {
    run_resize_and_assign_strong();
@@ -460,7 +987,14 @@ int main() {
    TEST_ALL_TYPES(array_resize);
    TEST_ALL_TYPES(array_remove);
    TEST_ALL_TYPES(array_insert);
+   TEST_ALL_REAL_TYPES(array_memory_resource);
    TEST_ALL_REAL_TYPES(array_data);
+   TEST_ALL_REAL_TYPES(array_contiguous);
+   TEST_ALL_FLOAT_TYPES(array_expression);
+   TEST_ALL_FLOAT_TYPES(array_strided_expression);
+   TEST_ALL_FLOAT_TYPES(array_index_expression);
+   TEST_ALL_FLOAT_TYPES(array_transpose_expression);
+   TEST_ALL_FLOAT_TYPES(array_reduction);
    TEST_NON_TYPE(array_strong_guarantee);
 
    return EXIT_SUCCESS;
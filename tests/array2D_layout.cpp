@@ -0,0 +1,176 @@
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+
+#include "test.hpp"
+
+
+using namespace spp;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T>
+void run_padded(ImplicitInt m, ImplicitInt n) {
+   static_assert(!detail::ContiguousBaseType<PaddedArray2D<T>>);
+   static_assert(detail::RowContiguousBaseType<PaddedArray2D<T>>);
+
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(9)});
+   PaddedArray2D<T> P = A;
+   ASSERT(P.leading_dim() >= n.get());
+   ASSERT(P.leading_dim() * to_index_t(sizeof(T)) % 4096_sl != 0_sl);
+   for(index_t i = 0_sl; i < m.get(); ++i) {
+      const auto addr = reinterpret_cast<std::uintptr_t>(P.row_data(i));
+      ASSERT(addr % PaddedArray2D<T>::alignment == 0);
+      auto R = P.row(i);
+      ASSERT(R == A.row(i));
+      ASSERT(detail::contiguous_data(R) == P.row_data(i));
+   }
+   for(index_t j = 0_sl; j < n.get(); ++j) {
+      ASSERT(P.col(j) == A.col(j));
+   }
+   ASSERT(P.diag() == A.diag());
+   ASSERT(P.diag(n.get() - 1_sl) == A.diag(n.get() - 1_sl));
+   ASSERT(P.diag(1_sl - m.get()) == A.diag(1_sl - m.get()));
+   ASSERT(Array1D<T>(P.view1D()) == Array1D<T>(A.view1D()));
+   ASSERT(sum(P) == sum(A));
+   ASSERT(max(P) == max(A));
+
+   PaddedArray2D<T> Q(m, n);
+   Q = P + A - Strict<T>{T(1)};
+   ASSERT(Q == A + A - Strict<T>{T(1)});
+   Q = Strict<T>{T(4)};
+   ASSERT(Q == Array2D<T>(m, n, Strict<T>{T(4)}));
+   Q.row(0) = P.row(0);
+   Q.col(0) = A.col(0);
+   ASSERT(Q.row(0) == A.row(0));
+   ASSERT(Q.col(0) == A.col(0));
+
+   Array2D<T> B = transpose(P);
+   ASSERT(B == transpose(A));
+   const Array2D<T> C = transpose(B);
+   ASSERT(C == P);
+
+   Q.resize(m.get() + 1_sl, n.get() + 3_sl);
+   Q = Zero<T>;
+   Q(seqN(0, m), seqN(0, n)) = P;
+   Q.resize(m, n);
+   ASSERT(Q == A);
+}
+
+
+// Resizing keeps allocating from the memory resource the array was constructed with.
+template <Real T>
+void run_padded_resource() {
+   std::pmr::monotonic_buffer_resource buffer;
+   std::pmr::monotonic_buffer_resource other;
+   PaddedArray2D<T> P = [&buffer] {
+      ScopedMemoryResource scope(&buffer);
+      return PaddedArray2D<T>(3, 5, One<T>);
+   }();
+   ASSERT(P.resource() == &buffer);
+   P.resize(4, 6);
+   ASSERT(P.resource() == &buffer);
+   ASSERT(P(seqN(0, 3), seqN(0, 5)) == Array2D<T>(3, 5, One<T>));
+   ASSERT(all_zeros(P.row(3)) && all_zeros(P.col(5)));
+   {
+      ScopedMemoryResource scope(&other);
+      P.resize(2, 2, false);
+      P = {{One<T>, Zero<T>}, {Zero<T>, One<T>}};
+   }
+   ASSERT(P.resource() == &buffer);
+   ASSERT((P == Array2D<T>{{One<T>, Zero<T>}, {Zero<T>, One<T>}}));
+}
+
+
+template <Real T>
+void run_col_major(ImplicitInt m, ImplicitInt n) {
+   static_assert(!detail::ContiguousBaseType<Array2D<T, Unaligned, ColMajor>>);
+   static_assert(detail::ColContiguousBaseType<Array2D<T, Unaligned, ColMajor>>);
+
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(9)});
+   Array2D<T, Aligned, ColMajor> C = A;
+   ASSERT(C == A);
+   for(index_t j = 0_sl; j < n.get(); ++j) {
+      auto S = C.col(j);
+      ASSERT(S == A.col(j));
+      ASSERT(detail::contiguous_data(S) == C.col_data(j));
+      for(index_t i = 0_sl; i < m.get(); ++i) {
+         ASSERT(C.data()[(j * m.get() + i).val()] == A(i, j));
+      }
+   }
+   for(index_t i = 0_sl; i < m.get(); ++i) {
+      ASSERT(C.row(i) == A.row(i));
+   }
+   ASSERT(C.diag() == A.diag());
+   ASSERT(C.diag(n.get() - 1_sl) == A.diag(n.get() - 1_sl));
+   ASSERT(C.diag(1_sl - m.get()) == A.diag(1_sl - m.get()));
+   ASSERT(Array1D<T>(C.view1D()) == Array1D<T>(A.view1D()));
+   ASSERT(sum(C) == sum(A));
+   auto col_sum = [](const auto& x) { return sum(x); };
+   ASSERT(col_reduce(C, col_sum) == col_reduce(A, col_sum));
+
+   Array2D<T, Unaligned, ColMajor> D(m, n);
+   D = C + A - Strict<T>{T(1)};
+   ASSERT(D == A + A - Strict<T>{T(1)});
+   D = Strict<T>{T(4)};
+   ASSERT(D == Array2D<T>(m, n, Strict<T>{T(4)}));
+   D = transpose(transpose(C));
+   ASSERT(D == A);
+   Array2D<T> B = C;
+   ASSERT(B == A);
+   B = transpose(transpose(C)) * Strict<T>{T(2)};
+   ASSERT(B == A * Strict<T>{T(2)});
+
+   Array2D<T> R = A;
+   R.insert_col(0, A.col(n.get() - 1_sl)).insert_row_back(R.row(0));
+   D.insert_col(0, D.col(n.get() - 1_sl)).insert_row_back(D.row(0));
+   ASSERT(D == R);
+   R.insert_rows(1, R(seqN(0, 1), place::all)).insert_cols(0, R);
+   D.insert_rows(1, D(seqN(0, 1), place::all)).insert_cols(0, D);
+   ASSERT(D == R);
+   R.remove_rows(1, 1).remove_cols(0, n.get() + 1_sl);
+   D.remove_rows(1, 1).remove_cols(0, n.get() + 1_sl);
+   ASSERT(D == R);
+   R.remove_rows({0_sl, m.get()}).remove_cols({0});
+   D.remove_rows({0_sl, m.get()}).remove_cols({0});
+   ASSERT(D == R);
+
+   FixedArray2D<T, 3, 4, Unaligned, ColMajor> F = A(seqN(0, 3), seqN(0, 4));
+   ASSERT(F == A(seqN(0, 3), seqN(0, 4)));
+   ASSERT(F.col_data(1)[2] == A(2, 1));
+   const auto S = F.row(2);
+   for(index_t j = 0_sl; j < 4_sl; ++j) {
+      ASSERT(S[j] == A(2, j));
+   }
+}
+
+
+template <Real T>
+void array_padded() {
+   for(index_t m = 1_sl; m < 10_sl; m += 4_sl) {
+      for(index_t n = 1_sl; n < 40_sl; n += 3_sl) {
+         run_padded<T>(m, n);
+      }
+   }
+   run_padded<T>(7, 4096);
+   run_padded_resource<T>();
+   ASSERT(PaddedArray2D<T>::padded_cols(0_sl) == 0_sl);
+}
+
+
+template <Real T>
+void array_col_major() {
+   for(index_t m = 4_sl; m < 20_sl; m += 5_sl) {
+      for(index_t n = 4_sl; n < 30_sl; n += 7_sl) {
+         run_col_major<T>(m, n);
+      }
+   }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(array_padded);
+   TEST_ALL_REAL_TYPES(array_col_major);
+   return EXIT_SUCCESS;
+}
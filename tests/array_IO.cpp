@@ -0,0 +1,989 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+
+
+using namespace spp;
+
+
+static std::string temp_path(const std::string& name) {
+   return std::filesystem::temp_directory_path() / name;
+}
+
+
+static void write_text(const std::string& path, const std::string& text) {
+   std::ofstream ofs(path, std::ios::binary);
+   ofs << text;
+}
+
+
+// Overwrites the bytes at offset, counted from the end of the file if offset is negative.
+template <typename U>
+static void patch_file(const std::string& path, long int offset, U value) {
+   std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+   fs.seekp(offset, offset < 0 ? std::ios::end : std::ios::beg);
+   fs.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+template <Builtin T>
+Array2D<T> sequence2D(ImplicitInt m, ImplicitInt n) {
+   Array2D<T> A(m, n);
+   for(index_t i = 0_sl; i < A.size(); ++i) {
+      A.un(i) = Strict<T>{T((i % 7_sl).val())};
+   }
+   return A;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Builtin T>
+void run_binary1D(ImplicitInt n) {
+   const std::string path = temp_path("garray_binary1D.bin");
+   const Array2D<T> S = sequence2D<T>(1, n);
+   const Array1D<T> A = S.row(0);
+
+   save_binary(path, A);
+   ASSERT(std::filesystem::file_size(path) == BinaryHeader::size + std::size_t(n.get().val()) * sizeof(T));
+   Array1D<T, Aligned> B(3);
+   load_binary(path, B);
+   ASSERT(B == A);
+
+   FixedArray1D<T, 5> F;
+   if(n.get() == 5_sl) {
+      load_binary(path, F);
+      ASSERT(F == A);
+   } else {
+      REQUIRE_THROW(load_binary(path, F));
+   }
+
+   // Strided slices are gathered in chunks, contiguous ones are written directly.
+   save_binary(path, A(seq(0, n.get() - 1_sl, 2)));
+   load_binary(path, B);
+   ASSERT(B == A(seq(0, n.get() - 1_sl, 2)));
+   Array1D<T> C(n, Strict<T>{T(1)});
+   load_binary(path, C(seq(0, n.get() - 1_sl, 2)));
+   for(index_t i = 0_sl; i < n.get(); ++i) {
+      ASSERT(C[i] == (i % 2_sl == 0_sl ? A[i] : Strict<T>{T(1)}));
+   }
+
+   Array2D<T> D;
+   REQUIRE_THROW(load_binary(path, D));
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_binary2D(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_binary2D.bin");
+   const Array2D<T> A = sequence2D<T>(m, n);
+
+   save_binary(path, A);
+   Array2D<T> B;
+   load_binary(path, B);
+   ASSERT(B == A);
+   Array2D<T, Aligned, ColMajor> C;
+   load_binary(path, C);
+   ASSERT(C == A);
+
+   // Column-major arrays are written in their storage order.
+   save_binary(path, C);
+   load_binary(path, B);
+   ASSERT(B == A);
+   load_binary(path, C);
+   ASSERT(C == A);
+
+   save_binary(path, transpose(A));
+   load_binary(path, B);
+   ASSERT(B == transpose(A));
+
+   save_binary(path, A(seq(1, m.get() - 1_sl), place::all));
+   Array2D<T> D(m, n, Strict<T>{T(1)});
+   load_binary(path, D(seq(0, m.get() - 2_sl), place::all));
+   ASSERT(D(seq(0, m.get() - 2_sl), place::all) == A(seq(1, m.get() - 1_sl), place::all));
+   ASSERT(D.row(m.get() - 1_sl) == Array1D<T>(n, Strict<T>{T(1)}));
+   REQUIRE_THROW(load_binary(path, D(place::all, place::all)));
+   REQUIRE_THROW(load_binary(path, D.view2D(n, m)));
+
+   Array1D<T> E;
+   REQUIRE_THROW(load_binary(path, E));
+   std::filesystem::remove(path);
+}
+
+
+template <Real T>
+void run_binary_padded(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_binary_padded.bin");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   const PaddedArray2D<T> P = A;
+   save_binary(path, P);
+   Array2D<T> B;
+   load_binary(path, B);
+   ASSERT(B == A);
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_binary_type_mismatch() {
+   const std::string path = temp_path("garray_binary_type.bin");
+   save_binary(path, Array1D<T>(4));
+   if constexpr(SameAs<T, int>) {
+      Array1D<long int> A;
+      REQUIRE_THROW(load_binary(path, A));
+   } else {
+      Array1D<int> A;
+      REQUIRE_THROW(load_binary(path, A));
+   }
+   std::filesystem::remove(path);
+}
+
+
+// Dimensions of corrupt files are checked against the size of the file before allocation.
+template <Builtin T>
+void run_binary_corrupt() {
+   const std::string path = temp_path("garray_binary_corrupt.bin");
+   const auto dims = long(offsetof(BinaryHeader, dims));
+   save_binary(path, Array1D<T>(4));
+   patch_file(path, dims, std::int64_t{1} << 60);
+   Array1D<T> A;
+   REQUIRE_THROW(load_binary(path, A));
+
+   save_binary(path, Array2D<T>(2, 2));
+   patch_file(path, dims, std::int64_t{1} << 40);
+   patch_file(path, dims + 8, std::int64_t{1} << 40);
+   Array2D<T> B;
+   REQUIRE_THROW(load_binary(path, B));
+   patch_file(path, dims, std::int64_t{2});
+   patch_file(path, dims + 8, std::int64_t{3});
+   REQUIRE_THROW(load_binary(path, B));
+   patch_file(path, dims + 8, std::int64_t{2});
+   load_binary(path, B);
+   ASSERT(B == Array2D<T>(2, 2));
+   std::filesystem::remove(path);
+}
+
+
+// Files written on machines with the opposite byte order are converted when loaded.
+template <Real T>
+void run_binary_byte_order(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_binary_byte_order.bin");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   save_binary(path, A);
+
+   std::vector<char> bytes;
+   {
+      std::ifstream ifs(path, std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+   }
+   BinaryHeader h;
+   std::copy_n(bytes.data(), sizeof(h), reinterpret_cast<char*>(&h));
+   h.little_endian = !h.little_endian;
+   detail::byteswap_header(h);
+   std::copy_n(reinterpret_cast<const char*>(&h), sizeof(h), bytes.data());
+   detail::byteswap_bytes(bytes.data() + sizeof(h), sizeof(T), std::size_t(A.size().val()));
+   {
+      std::ofstream ofs(path, std::ios::binary);
+      ofs.write(bytes.data(), std::streamsize(bytes.size()));
+   }
+
+   Array2D<T> B;
+   load_binary(path, B);
+   ASSERT(B == A);
+   Array2D<T> C(m, n);
+   load_binary(path, C(place::all, place::all));
+   ASSERT(C == A);
+   std::filesystem::remove(path);
+}
+
+
+#ifdef __linux__
+template <Real T>
+void run_mapped_file(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_mapped_file.bin");
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(9)});
+   const std::size_t bytes = std::size_t(A.size().val()) * sizeof(T);
+   {
+      auto file = MappedFile::create(path, sizeof(T) + bytes);
+      auto B = attach2D<T>(file, m, n, sizeof(T));
+      B = A;
+      attach1D<T>(file, 1)[0] = Strict<T>{T(m.get().val())};
+      file.sync();
+   }
+
+   {
+      const MappedFile file(path);
+      ASSERT(file.size() == sizeof(T) + bytes);
+      ASSERT(attach1D<T>(file)[0] == Strict<T>{T(m.get().val())});
+      const auto B = attach2D<T>(file, m, n, sizeof(T));
+      ASSERT(B == A);
+      ASSERT(B.row(m.get() - 1_sl) == A.row(m.get() - 1_sl));
+      ASSERT(B(seq(1, m.get() - 1_sl), place::all) == A(seq(1, m.get() - 1_sl), place::all));
+      ASSERT(sum(B) == sum(A));
+      ASSERT(max(B) == max(A));
+   }
+
+   // Copy-on-write changes are not written to the file.
+   {
+      MappedFile file(path, MapMode::CopyOnWrite);
+      file.advise(MapAdvice::Sequential);
+      auto B = attach2D<T>(file, m, n, sizeof(T));
+      B += A;
+      ASSERT(B == A + A);
+   }
+   {
+      MappedFile file(path, MapMode::ReadWrite);
+      file.advise(MapAdvice::Random, sizeof(T));
+      file.advise(MapAdvice::WillNeed);
+      auto B = attach2D<T>(file, m, n, sizeof(T));
+      ASSERT(B == A);
+      B.col(0) = Zero<T>;
+   }
+   {
+      const MappedFile file(path);
+      const auto B = attach2D<T>(file, m, n, sizeof(T));
+      ASSERT(all_zeros(B.col(0)));
+      ASSERT(B(place::all, seq(1, n.get() - 1_sl)) == A(place::all, seq(1, n.get() - 1_sl)));
+   }
+
+   MappedFile file(path);
+   REQUIRE_THROW(static_cast<void>(file.data<T>()));
+   REQUIRE_THROW(static_cast<void>(attach1D<T>(std::as_const(file), 2_sl + m.get() * n.get())));
+   // Sizes and offsets for which the number of bytes would overflow.
+   const auto huge = index_t{std::numeric_limits<long int>::max()};
+   REQUIRE_THROW(static_cast<void>(attach1D<T>(file, -1)));
+   REQUIRE_THROW(static_cast<void>(attach1D<T>(file, huge)));
+   REQUIRE_THROW(static_cast<void>(attach1D<T>(file, 1, std::size_t(-1))));
+   REQUIRE_THROW(static_cast<void>(attach2D<T>(file, huge, huge)));
+   REQUIRE_THROW(static_cast<void>(attach2D<T>(file, index_t{1L << 32}, index_t{1L << 32})));
+   REQUIRE_THROW(static_cast<void>(attach2D<T>(file, 1, 1, file.size() + 1)));
+   std::filesystem::remove(path);
+}
+
+
+template <Real T>
+void run_binary_mapped(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_binary_mapped.bin");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   save_binary(path, A);
+   {
+      const MappedFile file(path);
+      const auto B = attach_binary2D<T>(file);
+      ASSERT(B == A);
+      ASSERT(sum(B) == sum(A));
+      REQUIRE_THROW(static_cast<void>(attach_binary1D<T>(file)));
+   }
+   {
+      MappedFile file(path, MapMode::ReadWrite);
+      auto B = attach_binary2D<T>(file);
+      B.row(0) = Zero<T>;
+   }
+   Array2D<T> C;
+   load_binary(path, C);
+   ASSERT(all_zeros(C.row(0)));
+   ASSERT(C(seq(1, m.get() - 1_sl), place::all) == A(seq(1, m.get() - 1_sl), place::all));
+
+   const Array2D<T, Unaligned, ColMajor> D = A;
+   save_binary(path, D);
+   const MappedFile file(path);
+   REQUIRE_THROW(static_cast<void>(attach_binary2D<T>(file)));
+   std::filesystem::remove(path);
+}
+#endif
+
+
+template <Builtin T>
+void run_text1D(ImplicitInt n) {
+   const std::string path = temp_path("garray_text1D.txt");
+   const Array2D<T> S = sequence2D<T>(1, n);
+   const Array1D<T> A = S.row(0);
+   print_to_file(path, A);
+   Array1D<T> B;
+   read_from_file(path, B);
+   ASSERT(B == A);
+
+   array_format.row_style();
+   print_to_file(path, A);
+   array_format.reset();
+   read_from_file(path, B);
+   ASSERT(B == A);
+
+   std::istringstream iss{"1 0\n\n 1\t0\r\n"};
+   iss >> B;
+   ASSERT((B == Array1D<T>{One<T>, Zero<T>, One<T>, Zero<T>}));
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_text2D(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_text2D.txt");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   print_to_file(path, A);
+   Array2D<T> B;
+   read_from_file(path, B);
+   ASSERT(B == A);
+
+   // Blank lines are skipped, carriage returns are treated as spaces.
+   write_text(path, "\n  \n+1 0\r\n\n  0\t1  \n\n");
+   read_from_file(path, B);
+   ASSERT((B == Array2D<T>{{One<T>, Zero<T>}, {Zero<T>, One<T>}}));
+
+   // Column-major arrays are printed and read row by row as well.
+   const Array2D<T, Unaligned, ColMajor> C = A;
+   print_to_file(path, C);
+   Array2D<T, Aligned, ColMajor> D;
+   read_from_file(path, D);
+   ASSERT(D == A);
+   std::ifstream ifs(path);
+   Array2D<T, Unaligned, ColMajor> E;
+   ifs >> E;
+   ASSERT(E == C);
+   ifs.close();
+
+   write_text(path, " \n\t\n");
+   read_from_file(path, B);
+   ASSERT(B.empty());
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_text_invalid() {
+   const std::string path = temp_path("garray_text_invalid.txt");
+   Array1D<T> A;
+   Array2D<T> B;
+   REQUIRE_THROW(read_from_file(temp_path("garray_text_missing.txt"), A));
+
+   for(const char* text : {"1 0 x", "1 0 1x", "1 +-1", "1 +"}) {
+      write_text(path, text);
+      REQUIRE_THROW(read_from_file(path, A));
+      REQUIRE_THROW(read_from_file(path, B));
+      std::istringstream iss{text};
+      REQUIRE_THROW(iss >> A);
+   }
+
+   // Rows with different number of elements.
+   for(const char* text : {"1 0\n1\n", "1 0\n1 0 1\n", "1\n1\n1 1"}) {
+      write_text(path, text);
+      REQUIRE_THROW(read_from_file(path, B));
+      read_from_file(path, A);
+   }
+   std::filesystem::remove(path);
+}
+
+
+template <Floating T>
+void run_text_floating() {
+   const std::string path = temp_path("garray_text_floating.txt");
+   write_text(path, "-1.5 +2.25e1\n.5 3.\n");
+   Array2D<T> A;
+   read_from_file(path, A);
+   ASSERT((A == Array2D<T>{{Strict<T>{T(-1.5)}, Strict<T>{T(22.5)}}, {Strict<T>{T(0.5)}, Strict<T>{T(3)}}}));
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_npy1D(ImplicitInt n) {
+   const std::string path = temp_path("garray_npy1D.npy");
+   const Array2D<T> S = sequence2D<T>(1, n);
+   const Array1D<T> A = S.row(0);
+
+   save_npy(path, A);
+   ASSERT((std::filesystem::file_size(path) - std::size_t(n.get().val()) * sizeof(T)) % 64 == 0);
+   Array1D<T, Aligned> B;
+   load_npy(path, B);
+   ASSERT(B == A);
+   Array1D<T> C(n);
+   load_npy(path, C(place::all));
+   ASSERT(C == A);
+   REQUIRE_THROW(load_npy(path, C(seq(1, n.get() - 1_sl))));
+
+   Array2D<T> D;
+   REQUIRE_THROW(load_npy(path, D));
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_npy2D(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_npy2D.npy");
+   const Array2D<T> A = sequence2D<T>(m, n);
+
+   save_npy(path, A);
+   Array2D<T> B;
+   load_npy(path, B);
+   ASSERT(B == A);
+   Array2D<T, Aligned, ColMajor> C;
+   load_npy(path, C);
+   ASSERT(C == A);
+
+   // Column-major arrays are stored in Fortran order.
+   save_npy(path, C);
+   load_npy(path, B);
+   ASSERT(B == A);
+   load_npy(path, C);
+   ASSERT(C == A);
+
+   save_npy(path, transpose(A));
+   load_npy(path, B);
+   ASSERT(B == transpose(A));
+   Array2D<T> D(m, n);
+   REQUIRE_THROW(load_npy(path, D(place::all, place::all)));
+   load_npy(path, D.view2D(n, m));
+   ASSERT(D.view2D(n, m) == transpose(A));
+
+   Array1D<T> E;
+   REQUIRE_THROW(load_npy(path, E));
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_npy_type_mismatch() {
+   const std::string path = temp_path("garray_npy_type.npy");
+   save_npy(path, Array1D<T>(4));
+   if constexpr(SameAs<T, unsigned int>) {
+      Array1D<int> A;
+      REQUIRE_THROW(load_npy(path, A));
+   } else {
+      Array1D<unsigned int> A;
+      REQUIRE_THROW(load_npy(path, A));
+   }
+   std::filesystem::remove(path);
+}
+
+
+static void write_npy_raw(const std::string& path, char version, const std::string& dict,
+                          std::size_t alignment, const std::vector<char>& data) {
+   const std::size_t preamble = version == 1 ? 10 : 12;
+   std::string header = dict;
+   header.resize((preamble + dict.size() + 1 + alignment - 1) / alignment * alignment - preamble
+                     - 1,
+                 ' ');
+   header += '\n';
+   std::ofstream ofs(path, std::ios::binary);
+   ofs << "\x93NUMPY" << version << '\0';
+   for(std::size_t k = 0; k < preamble - 8; ++k) {
+      ofs << char(header.size() >> (8 * k) & 0xff);
+   }
+   ofs << header;
+   ofs.write(data.data(), std::streamsize(data.size()));
+}
+
+
+// Headers as written by different versions of NumPy.
+void run_npy_numpy() {
+   const std::string path = temp_path("garray_npy_numpy.npy");
+   const Array2D<double> A{{0._sd, 1._sd, 2._sd}, {3._sd, 4._sd, 5._sd}};
+   std::vector<char> row_major(6 * sizeof(double));
+   std::vector<char> col_major(6 * sizeof(double));
+   for(index_t k = 0_sl; k < 6_sl; ++k) {
+      const double x = A.un(k).val();
+      const double y = A.un(k % 2_sl, k / 2_sl).val();
+      std::memcpy(row_major.data() + k.val() * 8, &x, 8);
+      std::memcpy(col_major.data() + k.val() * 8, &y, 8);
+   }
+   const char* order = std::endian::native == std::endian::little ? "<" : ">";
+   const char* swapped = std::endian::native == std::endian::little ? ">" : "<";
+
+   Array2D<double> B;
+   write_npy_raw(path, 1, std::string("{'descr': '") + order + "f8', 'fortran_order': False, "
+                              + "'shape': (2, 3), }", 16, row_major);
+   load_npy(path, B);
+   ASSERT(B == A);
+
+   write_npy_raw(path, 2, std::string("{\"shape\": (2,3), \"fortran_order\": True, \"descr\": \"")
+                              + order + "f8\"}", 64, col_major);
+   load_npy(path, B);
+   ASSERT(B == A);
+
+   std::vector<char> swapped_data = row_major;
+   detail::byteswap_bytes(swapped_data.data(), 8, 6);
+   write_npy_raw(path, 3, std::string("{'descr': '") + swapped + "f8', 'fortran_order': False, "
+                              + "'shape': (2, 3), }", 64, swapped_data);
+   load_npy(path, B);
+   ASSERT(B == A);
+#ifdef __linux__
+   const MappedFile file(path);
+   REQUIRE_THROW(static_cast<void>(attach_npy2D<double>(file)));
+#endif
+
+   write_npy_raw(path, 1, "{'descr': '|b1', 'fortran_order': False, 'shape': (6,), }", 64,
+                 std::vector<char>{1, 0, 0, 1, 1, 0});
+   Array1D<bool> C;
+   load_npy(path, C);
+   ASSERT((C == Array1D<bool>{true_sb, false_sb, false_sb, true_sb, true_sb, false_sb}));
+
+   for(const char* dict : {"{'descr': '<f8', 'fortran_order': False}",
+                           "{'descr': '<f8', 'fortran_order': 0, 'shape': (2, 3), }",
+                           "{'descr': <f8, 'fortran_order': False, 'shape': (2, 3), }",
+                           "{'descr': '<f8', 'fortran_order': False, 'shape': (2, -3), }",
+                           "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 4), }",
+                           "{'descr': '<f8', 'fortran_order': False, "
+                           "'shape': (1099511627776, 1099511627776), }"}) {
+      write_npy_raw(path, 1, dict, 64, row_major);
+      REQUIRE_THROW(load_npy(path, B));
+   }
+
+   // Header length of almost 4 GiB in a file of 12 bytes.
+   write_text(path, std::string("\x93NUMPY\x02\x00\xff\xff\xff\xff", 12));
+   REQUIRE_THROW(load_npy(path, B));
+   REQUIRE_THROW(FileStream<double>(path, FileFormat::Npy));
+   std::filesystem::remove(path);
+}
+
+
+#ifdef __linux__
+template <Real T>
+void run_npy_mapped(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_npy_mapped.npy");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   save_npy(path, A);
+   {
+      const MappedFile file(path);
+      const auto B = attach_npy2D<T>(file);
+      ASSERT(B == A);
+      REQUIRE_THROW(static_cast<void>(attach_npy2D<T, ColMajor>(file)));
+      REQUIRE_THROW(static_cast<void>(attach_npy1D<T>(file)));
+   }
+
+   const Array2D<T, Unaligned, ColMajor> C = A;
+   save_npy(path, C);
+   {
+      MappedFile file(path, MapMode::ReadWrite);
+      auto B = attach_npy2D<T, ColMajor>(file);
+      ASSERT(B == A);
+      ASSERT(sum(B) == sum(A));
+      B.col(0) = Zero<T>;
+      REQUIRE_THROW(static_cast<void>(attach_npy2D<T>(file)));
+   }
+   Array2D<T> D;
+   load_npy(path, D);
+   ASSERT(all_zeros(D.col(0)));
+   ASSERT(D(place::all, seq(1, n.get() - 1_sl)) == A(place::all, seq(1, n.get() - 1_sl)));
+
+   save_npy(path, A.view1D());
+   const MappedFile file(path);
+   ASSERT(attach_npy1D<T>(file) == A.view1D());
+   std::filesystem::remove(path);
+}
+#endif
+
+
+// Arrays are printed element by element as operator<< prints numbers.
+template <Builtin T>
+void run_print_elements(ImplicitInt n) {
+   const Array2D<T> S = sequence2D<T>(1, n);
+   const Array1D<T> A = S.row(0);
+   std::ostringstream expected;
+   for(auto x : A) {
+      expected << x << '\n';
+   }
+   std::ostringstream printed;
+   printed << A;
+   ASSERT(printed.str() == expected.str());
+}
+
+
+// Numbers printed in shortest mode are read back exactly.
+template <Floating T>
+void run_print_shortest(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_print_shortest.txt");
+   Array2D<T> A = random<T>(m, n, -One<T>, One<T>);
+   A(0, 0) = Strict<T>{std::numeric_limits<T>::max()};
+   A(0, n.get() - 1_sl) = Strict<T>{std::numeric_limits<T>::denorm_min()};
+   format.shortest(true);
+   print_to_file(path, A);
+   format.reset();
+   Array2D<T> B;
+   read_from_file(path, B);
+   ASSERT(B == A);
+
+   format.shortest(true);
+   std::ostringstream os;
+   os << Strict<T>{T(0.5)} << " " << Strict<T>{T(-2.5)};
+   format.reset();
+   if constexpr(StandardFloating<T>) {
+      ASSERT(os.str() == "+0.5 -2.5");
+   }
+   std::filesystem::remove(path);
+}
+
+
+template <Real T>
+void run_stream(ImplicitInt m, ImplicitInt n, ImplicitInt min_block) {
+   const std::string path = temp_path("garray_stream");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   auto is_large = [](auto x) { return x > Strict<T>{T(5)}; };
+   auto is_small = [](auto x) { return x < Strict<T>{T(7)}; };
+
+   for(FileFormat format : {FileFormat::Binary, FileFormat::Npy, FileFormat::Text}) {
+      if(format == FileFormat::Binary) {
+         save_binary(path, A);
+      } else if(format == FileFormat::Npy) {
+         save_npy(path, A);
+      } else {
+         print_to_file(path, A);
+      }
+
+      for(index_t block : {min_block.get(), 7_sl * min_block.get(), A.size(), A.size() + 5_sl}) {
+         auto reduce_file = [&](auto reduction) {
+            FileStream<T> stream(path, format, block);
+            return reduction(stream);
+         };
+
+         // All blocks except the last one are full.
+         FileStream<T> stream(path, format, block);
+         Array1D<T> B(A.size());
+         index_t count{};
+         while(true) {
+            const auto x = stream.next();
+            if(x.empty()) {
+               break;
+            }
+            ASSERT(x.size() == block || count + x.size() == A.size());
+            for(index_t i = 0_sl; i < x.size(); ++i) {
+               B[count + i] = x[i];
+            }
+            count += x.size();
+         }
+         ASSERT(count == A.size() && B == A.view1D());
+         ASSERT(stream.next().empty());
+
+         ASSERT(reduce_file([](auto& s) { return sum(s); }) == sum(A));
+         ASSERT(reduce_file([](auto& s) { return min(s); }) == min(A));
+         ASSERT(reduce_file([](auto& s) { return max(s); }) == max(A));
+         ASSERT(reduce_file([&](auto& s) { return any_of(s, is_large); }) == any_of(A, is_large));
+         ASSERT(reduce_file([&](auto& s) { return all_of(s, is_small); }) == all_of(A, is_small));
+         ASSERT(reduce_file([&](auto& s) {
+                   FileStream<T> s2(path, format, block);
+                   return dot_prod(s, s2);
+                }) == dot_prod(A, A));
+         if constexpr(Floating<T>) {
+            ASSERT(reduce_file([](auto& s) { return stable_sum(s); }) == stable_sum(A));
+            ASSERT(reduce_file([](auto& s) { return norm2(s); }) == norm2(A));
+         }
+      }
+   }
+
+   const std::string path2 = temp_path("garray_stream2");
+   save_binary(path2, Array1D<T>(A.size() + 1_sl));
+   FileStream<T> s1(path, FileFormat::Text, 4);
+   FileStream<T> s2(path2, FileFormat::Binary, 4);
+   REQUIRE_THROW(dot_prod(s1, s2));
+   std::filesystem::remove(path);
+   std::filesystem::remove(path2);
+}
+
+
+template <Real T>
+void run_stream_text() {
+   const std::string path = temp_path("garray_stream_text.txt");
+   // Tokens longer than the buffer of the stream.
+   write_text(path, "1 " + std::string(200, '0') + "2\n\n 3\t" + std::string(100, '0'));
+   FileStream<T> s1(path, FileFormat::Text, 1);
+   ASSERT(sum(s1) == Strict<T>{T(6)});
+   REQUIRE_THROW(FileStream<T>(path, FileFormat::Text, 0));
+   REQUIRE_THROW(FileStream<T>(path, FileFormat::Text, -1));
+
+   write_text(path, " \n\t\n");
+   FileStream<T> s2(path, FileFormat::Text);
+   ASSERT(sum(s2, Strict<T>{T(3)}) == Strict<T>{T(3)});
+   FileStream<T> s3(path, FileFormat::Text);
+   ASSERT(!any_of(s3, [](auto) { return true_sb; }));
+   FileStream<T> s4(path, FileFormat::Text);
+   ASSERT(all_of(s4, [](auto) { return false_sb; }));
+
+   write_text(path, "1 2 x 4");
+   FileStream<T> s5(path, FileFormat::Text, 2);
+   REQUIRE_THROW(sum(s5));
+
+   save_binary(path, Array1D<T>{});
+   FileStream<T> s6(path, FileFormat::Binary);
+   ASSERT(max(s6).val() == T(0));
+   save_binary(path, Array1D<bool>{true_sb});
+   REQUIRE_THROW(FileStream<T>(path, FileFormat::Binary));
+   REQUIRE_THROW(FileStream<T>(path, FileFormat::Npy));
+   std::filesystem::remove(path);
+}
+
+
+template <Builtin T>
+void run_async(ImplicitInt m, ImplicitInt n) {
+   const std::string path1 = temp_path("garray_async1");
+   const std::string path2 = temp_path("garray_async2.npy");
+   const std::string path3 = temp_path("garray_async3.txt");
+   const Array2D<T> A = sequence2D<T>(m, n);
+
+   // Arrays are snapshotted, so they can be modified while files are being written.
+   Array2D<T> B = A;
+   auto f1 = save_binary_async(path1, B);
+   auto f2 = save_npy_async(path2, B.row(0));
+   auto f3 = print_to_file_async(path3, B);
+   B = Zero<T>;
+   f1.get();
+   f2.get();
+   f3.get();
+
+   // Files are loaded after they have been written.
+   Array2D<T, Aligned, ColMajor> C = A;
+   auto f4 = save_binary_async(path1, std::move(C));
+   auto g1 = load_binary_async<Array2D<T, Aligned, ColMajor>>(path1);
+   auto g2 = load_npy_async<Array1D<T>>(path2);
+   auto g3 = read_from_file_async<Array2D<T>>(path3);
+   f4.get();
+   ASSERT(g1.get() == A);
+   ASSERT(g2.get() == A.row(0));
+   ASSERT(g3.get() == A);
+
+   // Snapshots do not refer to memory resources of the caller, which may be released before
+   // the files are written.
+   std::future<void> f7, f8;
+   {
+      std::pmr::monotonic_buffer_resource buffer;
+      ScopedMemoryResource scope(&buffer);
+      Array2D<T> E = A;
+      Array1D<T> y = A.row(0);
+      f7 = save_binary_async(path1, E);
+      f8 = save_npy_async(path2, std::move(y));
+      E = Zero<T>;
+   }
+   f7.get();
+   f8.get();
+   ASSERT(load_binary_async<Array2D<T>>(path1).get() == A);
+   ASSERT(load_npy_async<Array1D<T>>(path2).get() == A.row(0));
+
+   // Errors are rethrown by the futures.
+   auto g4 = load_npy_async<Array2D<T>>(path1);
+   REQUIRE_THROW(g4.get());
+
+   set_io_threads(2);
+   ASSERT(io_threads() == 2_sl);
+   auto f5 = save_binary_async(path1, A);
+   auto f6 = save_npy_async(path2, A);
+   f5.get();
+   f6.get();
+   set_io_threads(1);
+   Array2D<T> D;
+   load_npy(path2, D);
+   ASSERT(D == A);
+
+   std::filesystem::remove(path1);
+   std::filesystem::remove(path2);
+   std::filesystem::remove(path3);
+}
+
+
+template <Builtin T>
+void run_archive(ImplicitInt m, ImplicitInt n) {
+   const std::string path = temp_path("garray_archive");
+   const Array2D<T> A = sequence2D<T>(m, n);
+   const Array1D<T> x = A.view1D();
+   const Array2D<T, Aligned, ColMajor> C = A;
+
+   {
+      ArchiveWriter writer(path);
+      writer.add("x", x);
+      writer.add("A", A);
+      writer.add("C", C);
+      writer.add("row", A.row(0));
+      writer.add("empty", Array1D<T>{});
+      REQUIRE_THROW(writer.add("A", A));
+      writer.close();
+      REQUIRE_THROW(writer.add("y", x));
+   }
+
+   const ArchiveReader reader(path);
+   ASSERT((reader.names() == std::vector<std::string>{"x", "A", "C", "row", "empty"}));
+   ASSERT(reader.contains("C") && !reader.contains("D"));
+
+   Array1D<T> y;
+   reader.load("x", y);
+   ASSERT(y == x);
+   reader.load("row", y);
+   ASSERT(y == A.row(0));
+   reader.load("empty", y);
+   ASSERT(y.empty());
+   Array2D<T> B;
+   reader.load("C", B);
+   ASSERT(B == A);
+   Array2D<T, Aligned, ColMajor> D;
+   reader.load("A", D);
+   ASSERT(D == A);
+
+   REQUIRE_THROW(reader.load("D", y));
+   REQUIRE_THROW(reader.load("A", y));
+   REQUIRE_THROW(reader.load("x", B));
+   Array1D<std::conditional_t<Boolean<T>, int, bool>> z;
+   REQUIRE_THROW(reader.load("x", z));
+
+#ifdef __linux__
+   ArchiveReader mapped(path);
+   ASSERT(mapped.attach1D<T>("x") == x);
+   ASSERT(mapped.attach2D<T>("A") == A);
+   ASSERT((mapped.attach2D<T, ColMajor>("C") == A));
+   REQUIRE_THROW(mapped.attach2D<T>("C"));
+#endif
+
+   // Archives that are not closed explicitly are closed by the destructor of the writer.
+   {
+      ArchiveWriter writer(path);
+      writer.add("x", x);
+   }
+   ArchiveReader(path).load("x", y);
+   ASSERT(y == x);
+
+   // Number of arrays in the table of contents larger than the file can hold.
+   const auto count = long(offsetof(ArchiveHeader, count)) - long(sizeof(ArchiveHeader));
+   patch_file(path, count, std::uint64_t{1} << 58);
+   REQUIRE_THROW(ArchiveReader{path});
+   patch_file(path, count, std::uint64_t{1});
+   ArchiveReader(path).load("x", y);
+   ASSERT(y == x);
+
+   // Dimensions of the array larger than the file can hold. The entry of "x" starts with
+   // the length of the name and the name.
+   std::uint64_t toc{};
+   std::ifstream ifs(path, std::ios::binary);
+   ifs.seekg(long(offsetof(ArchiveHeader, toc_offset)) - long(sizeof(ArchiveHeader)),
+             std::ios::end);
+   ifs.read(reinterpret_cast<char*>(&toc), sizeof(toc));
+   ifs.close();
+   patch_file(path, long(toc) + 5L + long(offsetof(BinaryHeader, dims)), std::int64_t{1} << 60);
+   REQUIRE_THROW(ArchiveReader(path).load("x", y));
+
+   std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+   REQUIRE_THROW(ArchiveReader{path});
+   std::filesystem::remove(path);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Builtin T>
+void binary_IO() {
+   run_binary1D<T>(1);
+   run_binary1D<T>(5);
+   run_binary1D<T>(300001);
+   run_binary2D<T>(2, 1);
+   run_binary2D<T>(13, 7);
+   run_binary2D<T>(700, 500);
+   run_binary_type_mismatch<T>();
+   run_binary_corrupt<T>();
+}
+
+
+template <Builtin T>
+void npy_IO() {
+   run_npy1D<T>(1);
+   run_npy1D<T>(5);
+   run_npy1D<T>(300001);
+   run_npy2D<T>(2, 1);
+   run_npy2D<T>(13, 7);
+   run_npy2D<T>(700, 500);
+   run_npy_type_mismatch<T>();
+}
+
+
+template <Real T>
+void npy_IO_real() {
+#ifdef __linux__
+   run_npy_mapped<T>(13, 7);
+#endif
+}
+
+
+template <Builtin T>
+void text_IO() {
+   run_text1D<T>(1);
+   run_text1D<T>(5);
+   run_text1D<T>(3001);
+   run_text2D<T>(1, 1);
+   run_text2D<T>(13, 7);
+   run_text2D<T>(70, 50);
+   run_text_invalid<T>();
+   run_print_elements<T>(1);
+   run_print_elements<T>(40000);
+}
+
+
+template <Floating T>
+void text_IO_floating() {
+   run_text_floating<T>();
+   run_print_shortest<T>(1, 1);
+   run_print_shortest<T>(13, 7);
+}
+
+
+template <Builtin T>
+void archive_IO() {
+   run_archive<T>(1, 1);
+   run_archive<T>(13, 7);
+   run_archive<T>(300, 200);
+}
+
+
+template <Builtin T>
+void async_IO() {
+   run_async<T>(1, 1);
+   run_async<T>(300, 200);
+}
+
+
+template <Real T>
+void stream_IO() {
+   run_stream<T>(1, 1, 1);
+   run_stream<T>(13, 7, 1);
+   run_stream<T>(700, 500, 1000);
+   run_stream_text<T>();
+}
+
+
+template <Real T>
+void mapped_file() {
+#ifdef __linux__
+   run_mapped_file<T>(2, 2);
+   run_mapped_file<T>(7, 13);
+   run_mapped_file<T>(300, 1000);
+#endif
+}
+
+
+template <Real T>
+void binary_IO_real() {
+   run_binary_padded<T>(13, 7);
+   run_binary_byte_order<T>(13, 7);
+#ifdef __linux__
+   run_binary_mapped<T>(13, 7);
+#endif
+}
+
+
+int main() {
+   TEST_ALL_REAL_TYPES(mapped_file);
+   TEST_ALL_TYPES(binary_IO);
+   TEST_ALL_REAL_TYPES(binary_IO_real);
+   TEST_ALL_TYPES(npy_IO);
+   TEST_ALL_REAL_TYPES(npy_IO_real);
+   TEST_NON_TYPE(run_npy_numpy);
+   TEST_ALL_TYPES(text_IO);
+   TEST_ALL_FLOAT_TYPES(text_IO_floating);
+   TEST_ALL_REAL_TYPES(stream_IO);
+   TEST_ALL_TYPES(async_IO);
+   TEST_ALL_TYPES(archive_IO);
+   return EXIT_SUCCESS;
+}
@@ -1,3 +1,4 @@
+#include <bit>
 #include <cstdlib>
 #include <utility>
 
@@ -35,6 +36,9 @@ consteval void array1D() {
    E.resize_and_assign(std::move(C));
    E.resize(20);
    E.resize(20, false);
+   E.reserve(40);
+   E.capacity();
+   E.shrink_to_fit();
 
    E.remove(0);
    E.remove(0, 1);
@@ -176,6 +180,54 @@ consteval void array2D() {
 }
 
 
+// Rows and columns are moved within the storage of the array, including when the
+// inserted rows or columns refer to the array itself.
+template <typename T>
+consteval void array2D_in_place() {
+   Array2D<T> B(4, 5);
+   for(index_t i = 0_sl; i < B.size(); ++i) {
+      B.un(i) = Strict<T>{T(i.val())};
+   }
+
+   Array2D<T> A = B;
+   A.insert_rows(1, A);
+   ASSERT(A.rows() == 8_sl);
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      const index_t r = i < 1_sl ? i : (i < 5_sl ? i - 1_sl : i - 4_sl);
+      for(index_t j = 0_sl; j < A.cols(); ++j) {
+         ASSERT(A(i, j) == B(r, j));
+      }
+   }
+
+   A.resize_and_assign(B);
+   A.insert_cols(2, A.cols({0, 1}));
+   A.insert_col(0, A.col(6));
+   ASSERT(A.cols() == 8_sl);
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      ASSERT(A(i, 0) == B(i, 4));
+      for(index_t j = 1_sl; j < A.cols(); ++j) {
+         const index_t c = j < 3_sl ? j - 1_sl : j - 3_sl;
+         ASSERT(A(i, j) == B(i, c));
+      }
+   }
+
+   A.resize_and_assign(B);
+   A.insert_row(2, A.row(0));
+   A.remove_rows({0, 3});
+   A.remove_cols(1, 3);
+   ASSERT(A.rows() == 3_sl && A.cols() == 2_sl);
+   for(index_t j = 0_sl; j < A.cols(); ++j) {
+      const index_t c = j == 0_sl ? 0_sl : 4_sl;
+      ASSERT(A(0, j) == B(1, c));
+      ASSERT(A(1, j) == B(0, c));
+      ASSERT(A(2, j) == B(3, c));
+   }
+
+   A.remove_cols({0, 1});
+   ASSERT(A.rows() == 0_sl && A.cols() == 0_sl);
+}
+
+
 template <typename T>
 consteval void fixed_array2D() {
    FixedArray2D<T, 2, 2>{};
@@ -200,6 +252,19 @@ consteval void fixed_array2D() {
 }
 
 
+template <typename T>
+consteval void alignment() {
+   static_assert(Array1D<T>::alignment == alignof(T));
+   static_assert(Array1D<T, Aligned>::alignment >= STRICT_ALIGNMENT);
+   static_assert(Array2D<T, Aligned>::alignment == Array1D<T, Aligned>::alignment);
+   static_assert(FixedArray1D<T, 3>::alignment == alignof(T));
+   static_assert(FixedArray1D<T, 3, Aligned>::alignment == std::bit_ceil(3 * sizeof(T)));
+   static_assert(FixedArray1D<T, 1000, Aligned>::alignment == Array1D<T, Aligned>::alignment);
+   static_assert(FixedArray2D<T, 1, 3, Aligned>::alignment
+                 == FixedArray1D<T, 3, Aligned>::alignment);
+}
+
+
 template <typename T>
 consteval void array_ops() {
    Array2D<T> x(3, 2);
@@ -212,6 +277,9 @@ consteval void array_ops() {
    min_index(x);
    max_index(x);
    dot_prod(x, x);
+   Array1D<T> v(2), w(3);
+   Array1D<T> y = matvec_prod(x, v);
+   Array1D<T> z = vecmat_prod(w, x);
    norm_inf(x);
    norm1(x);
    norm1_scaled(x);
@@ -498,7 +566,9 @@ int main() {
    TEST_ALL_TYPES(array1D);
    TEST_ALL_TYPES(fixed_array1D);
    TEST_ALL_TYPES(array2D);
+   TEST_ALL_REAL_TYPES(array2D_in_place);
    TEST_ALL_TYPES(fixed_array2D);
+   TEST_ALL_TYPES(alignment);
    TEST_ALL_FLOAT_TYPES(array_ops);
    TEST_ALL_TYPES(expr_ops);
    TEST_ALL_TYPES(derived1D);
@@ -0,0 +1,165 @@
+#include <cstdlib>
+
+#include "test.hpp"
+
+
+using namespace spp;
+
+
+// Accumulates each element in the order of the inner index, as matmul does.
+template <typename Base1, typename Base2>
+auto matmul_reference(const Base1& A, const Base2& B) {
+   using T = BuiltinTypeOf<Base1>;
+   Array2D<T> C(A.rows(), B.cols());
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      for(index_t j = 0_sl; j < B.cols(); ++j) {
+         Strict<T> s{};
+         for(index_t k = 0_sl; k < A.cols(); ++k) {
+            s = detail::matmul_madd(A(i, k), B(k, j), s);
+         }
+         C(i, j) = s;
+      }
+   }
+   return C;
+}
+
+
+// Accumulates each element from left to right, as matvec_prod and vecmat_prod do.
+template <typename Base1, typename Base2>
+auto matvec_reference(const Base1& A, const Base2& x) {
+   Array1D<BuiltinTypeOf<Base1>> y(A.rows());
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      for(index_t j = 0_sl; j < A.cols(); ++j) {
+         y[i] += A(i, j) * x[j];
+      }
+   }
+   return y;
+}
+
+
+template <Real T>
+auto random_matrix(ImplicitInt m, ImplicitInt n) {
+   if constexpr(Floating<T>) {
+      return Array2D<T>(random<T>(m, n, -One<T>, One<T>));
+   } else {
+      return Array2D<T>(random<T>(m, n, Zero<T>, Strict<T>{T(9)}));
+   }
+}
+
+
+template <Real T>
+void run_matmul(ImplicitInt m, ImplicitInt n, ImplicitInt p) {
+   const auto A = random_matrix<T>(m, p);
+   const auto B = random_matrix<T>(p, n);
+   const auto At = random_matrix<T>(p, m);
+   const auto Bt = random_matrix<T>(n, p);
+
+   ASSERT(matmul(A, B) == matmul_reference(A, B));
+   ASSERT(matmul(transpose(At), B) == matmul_reference(transpose(At), B));
+   ASSERT(matmul(A, transpose(Bt)) == matmul_reference(A, transpose(Bt)));
+   ASSERT(matmul(A + A, Strict<T>{T(3)} * B) == matmul_reference(A + A, Strict<T>{T(3)} * B));
+}
+
+
+template <Real T>
+void run_matmul_slice(ImplicitInt m, ImplicitInt n, ImplicitInt p) {
+   const auto A = random_matrix<T>(2_sl * m.get(), p.get() + 3_sl);
+   const auto B = random_matrix<T>(p, n.get() + 1_sl);
+   auto SA = A(seqN(0, m, 2), seqN(3, p));
+   auto SB = B(seqN(0, p), seqN(1, n));
+   ASSERT(matmul(SA, SB) == matmul_reference(SA, SB));
+}
+
+
+template <Real T>
+void matmul_shapes() {
+   for(index_t m = 1_sl; m < 30_sl; m += 4_sl) {
+      for(index_t n = 1_sl; n < 40_sl; n += 5_sl) {
+         for(index_t p = 1_sl; p < 20_sl; p += 6_sl) {
+            run_matmul<T>(m, n, p);
+         }
+      }
+   }
+}
+
+
+template <Real T>
+void matmul_blocks() {
+   run_matmul<T>(250, 70, 600);
+   run_matmul<T>(3, 2100, 5);
+   run_matmul_slice<T>(31, 45, 270);
+}
+
+
+template <Real T>
+auto random_vector(ImplicitInt n) {
+   if constexpr(Floating<T>) {
+      return Array1D<T>(random<T>(n, -One<T>, One<T>));
+   } else {
+      return Array1D<T>(random<T>(n, Zero<T>, Strict<T>{T(9)}));
+   }
+}
+
+
+template <Real T>
+void run_matvec(ImplicitInt m, ImplicitInt n) {
+   const auto A = random_matrix<T>(m, n);
+   const auto At = random_matrix<T>(n, m);
+   const auto x = random_vector<T>(n);
+   const auto y = random_vector<T>(m);
+
+   ASSERT(Array1D<T>(matvec_prod(A, x)) == matvec_reference(A, x));
+   ASSERT(Array1D<T>(matvec_prod(transpose(At), x)) == matvec_reference(transpose(At), x));
+   ASSERT(Array1D<T>(matvec_prod(A + A, x + x)) == matvec_reference(A + A, x + x));
+   const auto Ax = matvec_reference(A, x);
+   ASSERT(Array1D<T>(matvec_prod(A, x) + x[0]) == Array1D<T>(Ax + x[0]));
+
+   ASSERT(Array1D<T>(vecmat_prod(y, A)) == matvec_reference(transpose(A), y));
+   const auto yA = matvec_reference(transpose(A), y);
+   ASSERT(Array1D<T>(vecmat_prod(y, A) + y[0]) == Array1D<T>(yA + y[0]));
+   ASSERT(Array1D<T>(vecmat_prod(y, transpose(At))) == matvec_reference(At, y));
+   ASSERT(Array1D<T>(vecmat_prod(y + y, A + A)) == matvec_reference(transpose(A + A), y + y));
+}
+
+
+template <Real T>
+void run_matvec_slice(ImplicitInt m, ImplicitInt n) {
+   const auto A = random_matrix<T>(2_sl * m.get(), n.get() + 3_sl);
+   const auto x = random_vector<T>(2_sl * n.get());
+   const auto y = random_vector<T>(m);
+   auto SA = A(seqN(0, m, 2), seqN(3, n));
+   auto sx = x(seqN(0, n, 2));
+   ASSERT(Array1D<T>(matvec_prod(SA, sx)) == matvec_reference(SA, sx));
+   ASSERT(Array1D<T>(vecmat_prod(y, SA)) == matvec_reference(transpose(SA), y));
+}
+
+
+template <Real T>
+void matvec_shapes() {
+   for(index_t m = 1_sl; m < 40_sl; m += 3_sl) {
+      for(index_t n = 1_sl; n < 40_sl; n += 5_sl) {
+         run_matvec<T>(m, n);
+         run_matvec_slice<T>(m, n);
+      }
+   }
+   run_matvec<T>(301, 1000);
+}
+
+
+void matmul_empty() {
+   Array2D<double> A;
+   ASSERT(matmul(A, A).empty());
+
+   Array1D<double> x;
+   ASSERT(Array1D<double>(matvec_prod(A, x)).empty());
+   ASSERT(Array1D<double>(vecmat_prod(x, A)).empty());
+}
+
+
+int main() {
+   TEST_ALL_REAL_TYPES(matmul_shapes);
+   TEST_ALL_REAL_TYPES(matmul_blocks);
+   TEST_ALL_REAL_TYPES(matvec_shapes);
+   TEST_NON_TYPE(matmul_empty);
+   return EXIT_SUCCESS;
+}
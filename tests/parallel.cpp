@@ -0,0 +1,325 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#define STRICT_PARALLEL
+#include "test.hpp"
+
+
+using namespace spp;
+
+
+// Evaluates f once serially and once in parallel and checks that results are identical.
+void run_serial_vs_parallel(auto f) {
+   set_parallel_threshold(std::numeric_limits<long int>::max());
+   auto x1 = f();
+   set_parallel_threshold(1);
+   auto x2 = f();
+   ASSERT(x1 == x2);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T, AlignmentFlag AF>
+void run_assign(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   const Array1D<T, AF> B = random<T>(n, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] {
+      Array1D<T, AF> C(n);
+      C = A * B + A / B - Strict<T>{T(3)};
+      return C;
+   });
+}
+
+
+template <Real T, AlignmentFlag AF>
+void run_assign_2D(ImplicitInt m, ImplicitInt n) {
+   const Array2D<T, AF> A = random<T>(m, n, One<T>, Strict<T>{T(2)});
+   const Array2D<T, AF> B = random<T>(m, n, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] {
+      Array2D<T, AF> C(m, n);
+      C = A * B + A / B - Strict<T>{T(3)};
+      return C;
+   });
+   run_serial_vs_parallel([&] {
+      Array2D<T, AF> C(n, m);
+      C = transpose(A);
+      return C;
+   });
+}
+
+
+template <Real T>
+void run_padded_2D(ImplicitInt m, ImplicitInt n) {
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(2)});
+   const PaddedArray2D<T> P = A;
+   run_serial_vs_parallel([&] {
+      PaddedArray2D<T> C(m, n);
+      C = P * A + P - Strict<T>{T(3)};
+      return C;
+   });
+   run_serial_vs_parallel([&] {
+      Array2D<T> C(m, n);
+      C = P;
+      return C;
+   });
+   run_serial_vs_parallel([&] {
+      PaddedArray2D<T> C(m, n);
+      C = Strict<T>{T(5)};
+      return C;
+   });
+   run_serial_vs_parallel([&] { return sum(P); });
+}
+
+
+template <Real T>
+void run_col_major_2D(ImplicitInt m, ImplicitInt n) {
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(2)});
+   const Array2D<T, Unaligned, ColMajor> B = A;
+   run_serial_vs_parallel([&] {
+      Array2D<T, Unaligned, ColMajor> C(m, n);
+      C = B * A + B - Strict<T>{T(3)};
+      return C;
+   });
+   run_serial_vs_parallel([&] {
+      Array2D<T> C(m, n);
+      C = B;
+      return C;
+   });
+   run_serial_vs_parallel([&] {
+      Array2D<T, Unaligned, ColMajor> C(m, n);
+      C = Strict<T>{T(5)};
+      return C;
+   });
+}
+
+
+template <Real T>
+void run_matmul(ImplicitInt m, ImplicitInt n, ImplicitInt p) {
+   const Array2D<T> A = random<T>(m, p, One<T>, Strict<T>{T(2)});
+   const Array2D<T> B = random<T>(n, p, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] { return matmul(A, transpose(B)); });
+}
+
+
+template <Real T>
+void run_matvec(ImplicitInt m, ImplicitInt n) {
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(2)});
+   const Array1D<T> x = random<T>(n, One<T>, Strict<T>{T(2)});
+   const Array1D<T> y = random<T>(m, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] { return Array1D<T>(matvec_prod(A, x)); });
+   run_serial_vs_parallel([&] { return Array1D<T>(vecmat_prod(y, A)); });
+}
+
+
+template <Real T, AlignmentFlag AF>
+void run_compound(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] {
+      Array1D<T, AF> C(n, One<T>);
+      C += A;
+      C *= A;
+      C -= Strict<T>{T(2)};
+      return C;
+   });
+}
+
+
+template <Real T, AlignmentFlag AF>
+void run_fill(ImplicitInt n) {
+   run_serial_vs_parallel([&] {
+      Array1D<T, AF> C(n);
+      C = Strict<T>{T(7)};
+      return C;
+   });
+}
+
+
+template <Real T, AlignmentFlag AF>
+void run_reduce(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   const Array1D<T, AF> B = random<T>(n, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] { return sum(A); });
+   run_serial_vs_parallel([&] { return min(A); });
+   run_serial_vs_parallel([&] { return max(A); });
+   run_serial_vs_parallel([&] { return dot_prod(A, B); });
+   if constexpr(Floating<T>) {
+      run_serial_vs_parallel([&] { return prod(A / B); });
+      run_serial_vs_parallel([&] { return norm2(A); });
+   }
+}
+
+
+// Elements are zeroed by the threads that later write them.
+template <Real T, AlignmentFlag AF>
+void run_first_touch(ImplicitInt n) {
+   const Array1D<T, AF> A = random<T>(n, One<T>, Strict<T>{T(2)});
+   run_serial_vs_parallel([&] { return Array1D<T, AF>(n, first_touch); });
+   run_serial_vs_parallel([&] {
+      Array1D<T, AF> C(n, first_touch);
+      C += A;
+      return C;
+   });
+   run_serial_vs_parallel([&] {
+      Array1D<T, AF> C(n, uninitialized);
+      C = A + A;
+      return C;
+   });
+   set_parallel_threshold(1);
+   const Array1D<T, AF> C(n, first_touch);
+   const Array2D<T, AF> D(n, n, first_touch);
+   ASSERT(C == Array1D<T>(n));
+   ASSERT(D == Array2D<T>(n, n));
+}
+
+
+// Text is split at line boundaries, a malformed row is reported by the thread parsing it.
+template <Real T>
+void run_read_text(ImplicitInt m, ImplicitInt n) {
+   const std::string path = std::filesystem::temp_directory_path() / "garray_parallel_text.txt";
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(9)});
+   print_to_file(path, A);
+   run_serial_vs_parallel([&] {
+      Array2D<T> B;
+      read_from_file(path, B);
+      return B;
+   });
+   run_serial_vs_parallel([&] {
+      Array1D<T> B;
+      read_from_file(path, B);
+      return B;
+   });
+
+   std::ofstream{path, std::ios::app} << "1 2\n";
+   set_parallel_threshold(1);
+   Array2D<T> B;
+   REQUIRE_THROW(read_from_file(path, B));
+   std::filesystem::remove(path);
+}
+
+
+// Blocks formatted by different threads are written in order.
+template <Real T>
+void run_print(ImplicitInt m, ImplicitInt n) {
+   const Array2D<T> A = random<T>(m, n, One<T>, Strict<T>{T(9)});
+   run_serial_vs_parallel([&] {
+      std::ostringstream os;
+      os << A << A.view1D();
+      return os.str();
+   });
+}
+
+
+void run_exception() {
+   set_parallel_threshold(1);
+   Array1D<int> A(1000, 1_si);
+   Array1D<int> B(1000, 1_si);
+   B[999] = 0_si;
+   REQUIRE_THROW(A /= B);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T>
+void parallel_assign() {
+   for(auto n : {0, 1, 63, 64, 65, 1000, 12345}) {
+      run_assign<T, Aligned>(n);
+      run_assign<T, Unaligned>(n);
+   }
+   run_assign_2D<T, Aligned>(37, 71);
+   run_assign_2D<T, Unaligned>(100, 3);
+   run_padded_2D<T>(37, 71);
+   run_padded_2D<T>(300, 1024);
+   run_col_major_2D<T>(37, 71);
+   run_col_major_2D<T>(300, 1024);
+}
+
+
+template <Real T>
+void parallel_matmul() {
+   run_matmul<T>(450, 70, 300);
+   run_matmul<T>(1, 1, 1);
+}
+
+
+template <Real T>
+void parallel_matvec() {
+   run_matvec<T>(1000, 37);
+   run_matvec<T>(37, 1000);
+   run_matvec<T>(1, 1);
+}
+
+
+template <Real T>
+void parallel_compound() {
+   for(auto n : {0, 1, 1000, 12345}) {
+      run_compound<T, Aligned>(n);
+      run_compound<T, Unaligned>(n);
+   }
+}
+
+
+template <Real T>
+void parallel_fill() {
+   for(auto n : {0, 1, 1000, 12345}) {
+      run_fill<T, Aligned>(n);
+      run_fill<T, Unaligned>(n);
+   }
+}
+
+
+template <Real T>
+void parallel_first_touch() {
+   for(auto n : {0, 1, 1000, 3000}) {
+      run_first_touch<T, Aligned>(n);
+      run_first_touch<T, Unaligned>(n);
+   }
+}
+
+
+template <Real T>
+void parallel_reduce() {
+   for(auto n : {1, 1000, 8192, 8193, 100000}) {
+      run_reduce<T, Aligned>(n);
+      run_reduce<T, Unaligned>(n);
+   }
+}
+
+
+template <Real T>
+void parallel_text() {
+   run_read_text<T>(1, 1);
+   run_read_text<T>(1000, 37);
+   run_read_text<T>(37, 1000);
+   run_print<T>(1, 1);
+   run_print<T>(1000, 37);
+   run_print<T>(37, 1000);
+}
+
+
+void parallel_exception() {
+#ifndef STRICT_DEBUG_OFF
+   run_exception();
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   set_parallel_threads(4);
+
+   TEST_ALL_REAL_TYPES(parallel_assign);
+   TEST_ALL_REAL_TYPES(parallel_matmul);
+   TEST_ALL_REAL_TYPES(parallel_matvec);
+   TEST_ALL_REAL_TYPES(parallel_compound);
+   TEST_ALL_REAL_TYPES(parallel_fill);
+   TEST_ALL_REAL_TYPES(parallel_first_touch);
+   TEST_ALL_REAL_TYPES(parallel_reduce);
+   TEST_ALL_REAL_TYPES(parallel_text);
+   TEST_NON_TYPE(parallel_exception);
+
+   return EXIT_SUCCESS;
+}
@@ -25,6 +25,9 @@ echo -e "\nRUNNING FIXED ARRAY 2D TESTS"
 echo -e "\nRUNNING ARRAY 1D TESTS"
 ./array1D.x
 
+echo -e "\nRUNNING ARRAY 2D LAYOUT TESTS"
+./array2D_layout.x
+
 echo -e "\nRUNNING ARRAY STABLE OPERATIONS TESTS"
 ./array_stable_ops.x
 
@@ -40,6 +43,15 @@ echo -e "\nRUNNING CONSTEXPR TESTS"
 echo -e "\nRUNNING EMPTY TESTS"
 ./empty.x
 
+echo -e "\nRUNNING PARALLEL TESTS"
+./parallel.x
+
+echo -e "\nRUNNING MATMUL TESTS"
+./matmul.x
+
+echo -e "\nRUNNING ARRAY IO TESTS"
+./array_IO.x
+
 echo -e ""
 make clean
 echo -e ""